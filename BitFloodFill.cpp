@@ -0,0 +1,319 @@
+﻿#include "BitFloodFill.h"
+#include <iostream>
+#include <algorithm>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Recuento de bits portátil (SWAR)
+int popCount64(uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+}
+
+}
+
+BitFloodFill::BitFloodFill(const Maze* m) : maze(m), rows(0), cols(0), rowWords(0), stride(0),
+    foundCell(-1), foundDistance(-1), cellsReached(0) {
+}
+
+void BitFloodFill::prepareBoards() {
+    // Los tableros se reservan al cambiar de tamaño; las máscaras se rehacen
+    // solo si cambiaron las paredes
+    int wordsPerRow = maze->getWordsPerRow();
+    size_t planeWords = static_cast<size_t>(maze->getRows()) * wordsPerRow;
+    const uint64_t* right = maze->getRightWallPlane();
+    const uint64_t* bottom = maze->getBottomWallPlane();
+
+    bool reshaped = maze->getRows() != rows || maze->getCols() != cols || openRight.empty();
+    if (reshaped) {
+        rows = maze->getRows();
+        cols = maze->getCols();
+#ifdef __AVX2__
+        // El bucle AVX2 avanza de 4 en 4 palabras
+        rowWords = (wordsPerRow + 3) / 4 * 4;
+#else
+        rowWords = wordsPerRow;
+#endif
+        stride = rowWords + 2;
+
+        size_t total = static_cast<size_t>(rows + 2) * stride;
+        openRight.assign(total, 0);
+        openBottom.assign(total, 0);
+        reached.assign(total, 0);
+        frontier.assign(total, 0);
+        next.assign(total, 0);
+
+        firstWord.resize(rows);
+        lastWord.resize(rows);
+        nextFirstWord.resize(rows);
+        nextLastWord.resize(rows);
+    }
+    rowLevel.assign(rows, -1);
+
+    if (!reshaped && std::equal(right, right + planeWords, loadedRight.begin()) &&
+        std::equal(bottom, bottom + planeWords, loadedBottom.begin())) {
+        return;
+    }
+
+    loadedRight.assign(right, right + planeWords);
+    loadedBottom.assign(bottom, bottom + planeWords);
+    loadWalls();
+}
+
+void BitFloodFill::loadWalls() {
+    int wordsPerRow = maze->getWordsPerRow();
+
+    // Máscaras de columnas: hacia la derecha solo hasta cols - 2
+    const uint64_t* right = maze->getRightWallPlane();
+    const uint64_t* bottom = maze->getBottomWallPlane();
+    for (int r = 0; r < rows; r++) {
+        uint64_t* openR = &openRight[static_cast<size_t>(r + 1) * stride + 1];
+        uint64_t* openB = &openBottom[static_cast<size_t>(r + 1) * stride + 1];
+        const uint64_t* rightRow = right + static_cast<size_t>(r) * wordsPerRow;
+        const uint64_t* bottomRow = bottom + static_cast<size_t>(r) * wordsPerRow;
+
+        for (int w = 0; w < wordsPerRow; w++) {
+            int valid = std::min(64, cols - w * 64);
+            int validRight = std::min(64, cols - 1 - w * 64);
+            uint64_t colMask = valid >= 64 ? ~uint64_t(0) : (uint64_t(1) << valid) - 1;
+            uint64_t rightMask = validRight >= 64 ? ~uint64_t(0) :
+                validRight <= 0 ? 0 : (uint64_t(1) << validRight) - 1;
+
+            openR[w] = ~rightRow[w] & rightMask;
+            openB[w] = r < rows - 1 ? ~bottomRow[w] & colMask : 0;
+        }
+    }
+}
+
+bool BitFloodFill::expandRow(int row, int lo, int hi) {
+    size_t base = static_cast<size_t>(row + 1) * stride;
+    const uint64_t* F = &frontier[base];
+    const uint64_t* fUp = F - stride;
+    const uint64_t* fDown = F + stride;
+    const uint64_t* R = &openRight[base];
+    const uint64_t* bUp = &openBottom[base - stride];
+    const uint64_t* B = &openBottom[base];
+    uint64_t* N = &next[base];
+    uint64_t* V = &reached[base];
+
+    int first = -1;
+    int last = -1;
+    int k = lo;
+
+#ifdef __AVX2__
+    // Las guardas permiten leer la palabra anterior y la siguiente sin
+    // comprobaciones: el acarreo entre palabras sale de cargas desalineadas.
+    // Los bloques de 4 empiezan en 1 + 4m y rowWords es múltiplo de 4, así
+    // que no se pasan de la fila.
+    k = 1 + (lo - 1) / 4 * 4;
+    for (; k <= hi; k += 4) {
+        __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(F + k));
+        __m256i fPrev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(F + k - 1));
+        __m256i fNext = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(F + k + 1));
+        __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(R + k));
+        __m256i rPrev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(R + k - 1));
+
+        __m256i toRight = _mm256_or_si256(_mm256_slli_epi64(_mm256_and_si256(f, r), 1),
+            _mm256_srli_epi64(_mm256_and_si256(fPrev, rPrev), 63));
+        __m256i toLeft = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(f, 1),
+            _mm256_slli_epi64(fNext, 63)), r);
+        __m256i fromUp = _mm256_and_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fUp + k)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bUp + k)));
+        __m256i fromDown = _mm256_and_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fDown + k)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(B + k)));
+
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(V + k));
+        __m256i fresh = _mm256_andnot_si256(v, _mm256_or_si256(
+            _mm256_or_si256(toRight, toLeft), _mm256_or_si256(fromUp, fromDown)));
+        if (_mm256_testz_si256(fresh, fresh)) continue;
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(N + k), fresh);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(V + k), _mm256_or_si256(v, fresh));
+
+        uint64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), fresh);
+        for (int lane = 0; lane < 4; lane++) {
+            if (lanes[lane] == 0) continue;
+            layerWord.push_back(base + k + lane);
+            layerBits.push_back(lanes[lane]);
+            cellsReached += popCount64(lanes[lane]);
+            if (first < 0) first = k + lane;
+            last = k + lane;
+        }
+    }
+#endif
+
+    for (; k <= hi; k++) {
+        uint64_t f = F[k];
+        uint64_t toRight = ((f & R[k]) << 1) | ((F[k - 1] & R[k - 1]) >> 63);
+        uint64_t toLeft = ((f >> 1) | (F[k + 1] << 63)) & R[k];
+        uint64_t fresh = (toRight | toLeft | (fUp[k] & bUp[k]) | (fDown[k] & B[k])) & ~V[k];
+        if (fresh == 0) continue;
+
+        N[k] = fresh;
+        V[k] |= fresh;
+        layerWord.push_back(base + k);
+        layerBits.push_back(fresh);
+        cellsReached += popCount64(fresh);
+        if (first < 0) first = k;
+        last = k;
+    }
+
+    if (first < 0) return false;
+    nextFirstWord[row] = first;
+    nextLastWord[row] = last;
+    return true;
+}
+
+int BitFloodFill::run(int source, const std::vector<int>& targets) {
+    foundCell = -1;
+    foundDistance = -1;
+    cellsReached = 0;
+    layerStart.clear();
+    layerWord.clear();
+    layerBits.clear();
+
+    if (maze == nullptr) {
+        std::cerr << "Error: Cannot flood fill - maze is null!" << std::endl;
+        return -1;
+    }
+    if (source < 0 || source >= maze->getTotalCells()) {
+        std::cerr << "Error: Invalid flood fill source cell " << source << std::endl;
+        return -1;
+    }
+
+    prepareBoards();
+
+    auto isReached = [&](int cell) {
+        return ((reached[wordOf(cell)] >> ((cell % cols) & 63)) & 1) != 0;
+    };
+    auto findTarget = [&]() {
+        for (int cell : targets) {
+            if (cell >= 0 && cell < rows * cols && isReached(cell)) return cell;
+        }
+        return -1;
+    };
+
+    // Nivel 0: solo el origen
+    uint64_t sourceBit = uint64_t(1) << ((source % cols) & 63);
+    frontier[wordOf(source)] = sourceBit;
+    reached[wordOf(source)] = sourceBit;
+    layerStart.push_back(0);
+    layerWord.push_back(wordOf(source));
+    layerBits.push_back(sourceBit);
+    cellsReached = 1;
+
+    activeRows.clear();
+    activeRows.push_back(source / cols);
+    firstWord[source / cols] = static_cast<int>(wordOf(source) % stride);
+    lastWord[source / cols] = firstWord[source / cols];
+    int level = 0;
+
+    foundCell = findTarget();
+    while (foundCell < 0 && !activeRows.empty()) {
+        // Filas que pueden recibir celdas nuevas: las de la frontera y sus
+        // vecinas, en orden ascendente y sin repetir
+        candidateRows.clear();
+        for (int row : activeRows) {
+            rowLevel[row] = level;
+        }
+        for (int row : activeRows) {
+            for (int r = row - 1; r <= row + 1; r++) {
+                if (r >= 0 && r < rows && (candidateRows.empty() || r > candidateRows.back())) {
+                    candidateRows.push_back(r);
+                }
+            }
+        }
+
+        layerStart.push_back(layerWord.size());
+        nextRows.clear();
+        for (int row : candidateRows) {
+            int lo = rowWords;
+            int hi = 1;
+            for (int r = row - 1; r <= row + 1; r++) {
+                if (r >= 0 && r < rows && rowLevel[r] == level) {
+                    lo = std::min(lo, firstWord[r] - 1);
+                    hi = std::max(hi, lastWord[r] + 1);
+                }
+            }
+            if (expandRow(row, std::max(lo, 1), std::min(hi, rowWords))) nextRows.push_back(row);
+        }
+
+        // La frontera vieja solo tiene bits en el rango de sus filas activas
+        for (int row : activeRows) {
+            size_t base = static_cast<size_t>(row + 1) * stride;
+            std::fill(frontier.begin() + base + firstWord[row], frontier.begin() + base + lastWord[row] + 1,
+                uint64_t(0));
+        }
+        frontier.swap(next);
+        activeRows.swap(nextRows);
+        firstWord.swap(nextFirstWord);
+        lastWord.swap(nextLastWord);
+        level++;
+
+        foundCell = findTarget();
+    }
+
+    // Dejar los tableros a cero para el siguiente recorrido: lo alcanzado y
+    // la última frontera están todos en las capas
+    for (size_t word : layerWord) {
+        reached[word] = 0;
+        frontier[word] = 0;
+    }
+
+    if (foundCell < 0) {
+        // El último nivel no añadió nada
+        layerStart.pop_back();
+        return -1;
+    }
+
+    foundDistance = level;
+    return foundCell;
+}
+
+bool BitFloodFill::inLayer(int level, int cell) const {
+    size_t word = wordOf(cell);
+    std::vector<size_t>::const_iterator first = layerWord.begin() + layerStart[level];
+    std::vector<size_t>::const_iterator last = level + 1 < static_cast<int>(layerStart.size()) ?
+        layerWord.begin() + layerStart[level + 1] : layerWord.end();
+
+    std::vector<size_t>::const_iterator it = std::lower_bound(first, last, word);
+    if (it == last || *it != word) return false;
+    return ((layerBits[it - layerWord.begin()] >> ((cell % cols) & 63)) & 1) != 0;
+}
+
+bool BitFloodFill::tracePath(std::vector<int>& path) const {
+    path.clear();
+    if (foundCell < 0) return false;
+
+    // Desde la capa d siempre hay una vecina abierta en la capa d - 1
+    int current = foundCell;
+    path.push_back(current);
+    for (int level = foundDistance; level > 0; level--) {
+        int row = current / cols;
+        int col = current % cols;
+        int previous = -1;
+        maze->forEachNeighbor(row, col, maze->accessibleNeighborMask(row, col),
+            [&](int nextRow, int nextCol, int) {
+                int cell = nextRow * cols + nextCol;
+                if (previous < 0 && inLayer(level - 1, cell)) previous = cell;
+            });
+
+        if (previous < 0) {
+            std::cerr << "Error: Broken distance layer " << level - 1 << std::endl;
+            path.clear();
+            return false;
+        }
+        current = previous;
+        path.push_back(current);
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
@@ -0,0 +1,83 @@
+﻿#ifndef BIT_FLOOD_FILL_H
+#define BIT_FLOOD_FILL_H
+
+#include "Maze.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Búsqueda en anchura de 64 celdas por palabra. El conjunto alcanzado y la
+// frontera son tableros de bits por filas; cada nivel se expande con
+// desplazamientos enmascarados por los planos de paredes abiertas, con AVX2
+// (4 palabras por instrucción) si se compila con __AVX2__ y con palabras de
+// 64 bits en otro caso. Solo se recorren las filas vecinas de la frontera.
+//
+// Cada nivel guarda las palabras nuevas (capa de distancia) de forma dispersa,
+// así el camino se recupera bajando de capa en capa desde el objetivo.
+class BitFloodFill {
+private:
+    const Maze* maze;
+    int rows;
+    int cols;
+
+    // Tableros con guardas: 'rows + 2' filas de 'stride' palabras; la fila r
+    // empieza en (r + 1) * stride y sus palabras útiles van de 1 a rowWords
+    // (múltiplo de 4 con AVX2). Las guardas valen 0 y evitan comprobar límites.
+    int rowWords;
+    int stride;
+    std::vector<uint64_t> openRight;    // Bit c: se puede pasar de c a c + 1
+    std::vector<uint64_t> openBottom;   // Bit c: se puede bajar a la fila siguiente
+    std::vector<uint64_t> reached;      // Entre recorridos quedan a cero
+    std::vector<uint64_t> frontier;
+    std::vector<uint64_t> next;
+
+    // Copia de los planos de paredes con que se calcularon openRight y
+    // openBottom: las máscaras solo se rehacen si el laberinto cambió
+    std::vector<uint64_t> loadedRight;
+    std::vector<uint64_t> loadedBottom;
+
+    std::vector<int> activeRows;        // Filas con frontera (ascendentes)
+    std::vector<int> candidateRows;
+    std::vector<int> nextRows;
+
+    // Rango de palabras con frontera de cada fila activa; solo se expande ese
+    // rango (más una palabra a cada lado) en la fila y en sus vecinas
+    std::vector<int> firstWord, lastWord;
+    std::vector<int> nextFirstWord, nextLastWord;
+    std::vector<int> rowLevel;          // Nivel en que la fila estuvo activa
+
+    // Capas: palabras nuevas del nivel d en [layerStart[d], layerStart[d + 1])
+    std::vector<size_t> layerStart;
+    std::vector<size_t> layerWord;
+    std::vector<uint64_t> layerBits;
+
+    int foundCell;
+    int foundDistance;
+    long long cellsReached;
+
+    size_t wordOf(int cell) const {
+        return static_cast<size_t>(cell / cols + 1) * stride + 1 + (cell % cols) / 64;
+    }
+
+    void prepareBoards();
+    void loadWalls();
+    bool expandRow(int row, int lo, int hi);
+    bool inLayer(int level, int cell) const;
+
+public:
+    explicit BitFloodFill(const Maze* m);
+
+    // Inundar desde 'source' hasta alcanzar alguna celda de 'targets' (o
+    // hasta agotar la región). Devuelve la celda alcanzada o -1.
+    int run(int source, const std::vector<int>& targets);
+
+    // Resultado del último run()
+    int getDistance() const { return foundDistance; }       // -1 si no se alcanzó
+    int getLevels() const { return static_cast<int>(layerStart.size()) - 1; }
+    long long getCellsReached() const { return cellsReached; }
+
+    // Camino del origen a la celda alcanzada en el último run()
+    bool tracePath(std::vector<int>& path) const;
+};
+
+#endif
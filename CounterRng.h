@@ -0,0 +1,48 @@
+﻿#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <cstdint>
+
+// Generador basado en contador: cada valor es un hash SplitMix64 de
+// (semilla, índice, paso), sin estado compartido. Dos hilos que piden el
+// mismo (semilla, índice, paso) obtienen el mismo número en cualquier orden,
+// así que la generación con semilla no depende del número de hilos.
+class CounterRng {
+private:
+    uint64_t key;       // Semilla e índice ya mezclados
+    uint64_t counter;   // Paso siguiente
+
+public:
+    typedef uint64_t result_type;
+
+    // Finalizador de SplitMix64
+    static uint64_t mix(uint64_t z) {
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static uint64_t hash(uint64_t seed, uint64_t index, uint64_t step) {
+        return mix(mix(mix(seed) ^ index) ^ step);
+    }
+
+    // Entero uniforme en [0, bound) a partir de un hash (bound < 2^32)
+    static uint32_t bounded(uint64_t value, uint32_t bound) {
+        return static_cast<uint32_t>(((value >> 32) * bound) >> 32);
+    }
+
+    // Flujo secuencial para (semilla, índice): el valor n-ésimo es hash(semilla, índice, n)
+    explicit CounterRng(uint64_t seed = 0, uint64_t index = 0)
+        : key(mix(mix(seed) ^ index)), counter(0) {
+    }
+
+    void seek(uint64_t step) { counter = step; }
+
+    result_type operator()() { return mix(key ^ counter++); }
+
+    static result_type min() { return 0; }
+    static result_type max() { return ~uint64_t(0); }
+};
+
+#endif
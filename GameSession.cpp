@@ -0,0 +1,36 @@
+﻿#include "GameSession.h"
+
+GameSession::GameSession(int rows, int cols, MazeAlgorithm initialAlgorithm)
+    : maze(rows, cols), generator(&maze), solver(&maze), player(&maze), algorithm(initialAlgorithm) {
+}
+
+void GameSession::prepare(int rows, int cols, MazeAlgorithm newAlgorithm) {
+    pregenerator.request(rows, cols, newAlgorithm);
+}
+
+void GameSession::start(int rows, int cols, MazeAlgorithm newAlgorithm) {
+    algorithm = newAlgorithm;
+    pregenerator.request(rows, cols, algorithm);
+
+    if (pregenerator.takeReady(rows, cols, algorithm, maze, pregeneratedSolution)) {
+        solver.adoptResult(pregeneratedSolution);
+    }
+    else {
+        if (rows != maze.getRows() || cols != maze.getCols()) {
+            maze.resize(rows, cols);
+        }
+        // La solución sale del árbol registrado al generar, sin pasada de BFS,
+        // en los algoritmos en que registrarlo compensa
+        bool useTree = recordTreePaysOff(algorithm);
+        generator.setRecordTree(useTree);
+        generator.generate(algorithm);
+        if (useTree) solver.solveFromTree(generator.getSpanningTree());
+        else solver.solveBFS();
+    }
+
+    player.reset();
+}
+
+void GameSession::next() {
+    start(maze.getRows(), maze.getCols(), algorithm);
+}
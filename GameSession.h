@@ -0,0 +1,50 @@
+﻿#ifndef GAME_SESSION_H
+#define GAME_SESSION_H
+
+#include "Maze.h"
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include "MazePregenerator.h"
+#include "Player.h"
+
+// Laberinto de la partida con su generador, solucionador y jugador. Todos
+// apuntan al mismo Maze durante toda la sesión: cambiar de configuración
+// redimensiona ese Maze en lugar de crear otro y reconstruir los demás.
+class GameSession {
+private:
+    Maze maze;
+    MazeGenerator generator;
+    MazeSolver solver;
+    Player player;
+
+    // Prepara en segundo plano el siguiente laberinto de la configuración actual
+    MazePregenerator pregenerator;
+    SolveResult pregeneratedSolution;
+
+    MazeAlgorithm algorithm;
+
+public:
+    GameSession(int rows, int cols, MazeAlgorithm initialAlgorithm = RECURSIVE_BACKTRACKER);
+
+    GameSession(const GameSession&) = delete;
+    GameSession& operator=(const GameSession&) = delete;
+
+    // Empezar a preparar en segundo plano un laberinto con esta configuración
+    // (al moverse por los menús); no toca el laberinto actual
+    void prepare(int rows, int cols, MazeAlgorithm newAlgorithm);
+
+    // Configuración confirmada: genera y resuelve una sola vez (o toma el ya
+    // preparado) y coloca al jugador en el inicio
+    void start(int rows, int cols, MazeAlgorithm newAlgorithm);
+
+    // Otro laberinto con la misma configuración
+    void next();
+
+    Maze& getMaze() { return maze; }
+    MazeGenerator& getGenerator() { return generator; }
+    MazeSolver& getSolver() { return solver; }
+    Player& getPlayer() { return player; }
+    MazeAlgorithm getAlgorithm() const { return algorithm; }
+};
+
+#endif
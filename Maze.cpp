@@ -1,83 +1,197 @@
 ﻿#include "Maze.h"
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <utility>
 
-Maze::Maze(int r, int c) : rows(r), cols(c) {
-    // Validación
+Maze::Maze(int r, int c) : rows(0), cols(0), wordsPerRow(0),
+    visitedEpoch(1), solutionEpoch(1), startIndex(0) {
+    resize(r, c);
+}
+
+Maze::Maze(Maze&& other) noexcept
+    : rows(other.rows), cols(other.cols), wordsPerRow(other.wordsPerRow),
+    rightWalls(std::move(other.rightWalls)), bottomWalls(std::move(other.bottomWalls)),
+    visitedStamps(std::move(other.visitedStamps)), solutionStamps(std::move(other.solutionStamps)),
+    visitedEpoch(other.visitedEpoch), solutionEpoch(other.solutionEpoch),
+    startIndex(other.startIndex), goalIndices(std::move(other.goalIndices)),
+    goalBits(std::move(other.goalBits)) {
+    other.rows = 0;
+    other.cols = 0;
+    other.wordsPerRow = 0;
+    other.startIndex = 0;
+}
+
+Maze& Maze::operator=(Maze&& other) noexcept {
+    if (this != &other) {
+        rows = other.rows;
+        cols = other.cols;
+        wordsPerRow = other.wordsPerRow;
+        rightWalls = std::move(other.rightWalls);
+        bottomWalls = std::move(other.bottomWalls);
+        visitedStamps = std::move(other.visitedStamps);
+        solutionStamps = std::move(other.solutionStamps);
+        visitedEpoch = other.visitedEpoch;
+        solutionEpoch = other.solutionEpoch;
+        startIndex = other.startIndex;
+        goalIndices = std::move(other.goalIndices);
+        goalBits = std::move(other.goalBits);
+
+        other.rows = 0;
+        other.cols = 0;
+        other.wordsPerRow = 0;
+        other.startIndex = 0;
+    }
+    return *this;
+}
+
+void Maze::resize(int r, int c) {
+    // Validación (antes de tocar nada)
     if (r <= 0 || c <= 0) {
         throw std::invalid_argument("Maze dimensions must be positive");
     }
 
-    if (r > 1000 || c > 1000) {
+    if (static_cast<long long>(r) * c > MAX_CELLS) {
         throw std::invalid_argument("Maze dimensions too large");
     }
 
-    // Inicialización de la cuadrícula
-    grid.resize(rows);
-    for (int i = 0; i < rows; i++) {
-        grid[i].resize(cols);
-        for (int j = 0; j < cols; j++) {
-            grid[i][j].row = i;
-            grid[i][j].col = j;
-        }
-    }
+    rows = r;
+    cols = c;
+
+    // Inicialización de los planos de bits; assign() conserva la capacidad
+    wordsPerRow = (cols + 63) / 64;
+    size_t words = static_cast<size_t>(rows) * wordsPerRow;
+
+    rightWalls.assign(words, ~uint64_t(0));
+    bottomWalls.assign(words, ~uint64_t(0));
+    visitedStamps.assign(static_cast<size_t>(rows) * cols, 0);
+    solutionStamps.assign(static_cast<size_t>(rows) * cols, 0);
+    goalBits.assign(words, 0);
+    visitedEpoch = 1;
+    solutionEpoch = 1;
 
     // Marcar el punto de inicio y el punto final
-    grid[0][0].isStart = true;
-    grid[rows - 1][cols - 1].isEnd = true;
+    goalIndices.clear();
+    setStart(0, 0);
+    setGoal(rows - 1, cols - 1);
 }
 
-Cell& Maze::getCell(int row, int col) {
+Cell Maze::getCell(int row, int col) {
     if (!isValidCell(row, col)) {
         throw std::out_of_range("Cell coordinates out of range");
     }
-    return grid[row][col];
+    return Cell(this, row, col);
 }
 
-const Cell& Maze::getCell(int row, int col) const {
+const Cell Maze::getCell(int row, int col) const {
     if (!isValidCell(row, col)) {
         throw std::out_of_range("Cell coordinates out of range");
     }
-    return grid[row][col];
+    return Cell(const_cast<Maze*>(this), row, col);
 }
 
 void Maze::reset() {
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            Cell& cell = grid[i][j];
-            cell.topWall = true;
-            cell.rightWall = true;
-            cell.bottomWall = true;
-            cell.leftWall = true;
-            cell.visited = false;
-            cell.inSolution = false;
-            // Mantener isStart e isEnd
+    std::fill(rightWalls.begin(), rightWalls.end(), ~uint64_t(0));
+    std::fill(bottomWalls.begin(), bottomWalls.end(), ~uint64_t(0));
+    clearVisited();
+    clearSolution();
+    // Mantener isStart e isEnd
+}
 
-        }
+void Maze::advanceEpoch(std::vector<uint8_t>& stamps, uint8_t& epoch) {
+    epoch++;
+    if (epoch == 0) {
+        // El sello 0 significa "sin marcar", así que nunca se usa como época
+        std::fill(stamps.begin(), stamps.end(), 0);
+        epoch = 1;
     }
 }
 
 void Maze::clearVisited() {
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            grid[i][j].visited = false;
-        }
-    }
+    advanceEpoch(visitedStamps, visitedEpoch);
 }
 
 void Maze::clearSolution() {
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            grid[i][j].inSolution = false;
+    advanceEpoch(solutionStamps, solutionEpoch);
+}
+
+void Maze::setWallRow(int row, const uint64_t* right, const uint64_t* bottom) {
+    size_t offset = static_cast<size_t>(row) * wordsPerRow;
+    std::copy(right, right + wordsPerRow, rightWalls.begin() + offset);
+    std::copy(bottom, bottom + wordsPerRow, bottomWalls.begin() + offset);
+}
+
+void Maze::setWallPlanes(const uint64_t* right, const uint64_t* bottom) {
+    std::copy(right, right + rightWalls.size(), rightWalls.begin());
+    std::copy(bottom, bottom + bottomWalls.size(), bottomWalls.begin());
+}
+
+void Maze::copyWallsFrom(const Maze& tile, int rowOffset, int colOffset) {
+    if (rowOffset < 0 || colOffset < 0 ||
+        rowOffset + tile.rows > rows || colOffset + tile.cols > cols) {
+        throw std::out_of_range("Tile does not fit inside the maze");
+    }
+
+    for (int i = 0; i < tile.rows; i++) {
+        if ((colOffset & 63) == 0) {
+            // Palabras alineadas; los bits de relleno de la última palabra de la
+            // tesela caen fuera de su región y solo pueden pisar relleno del destino
+            size_t src = static_cast<size_t>(i) * tile.wordsPerRow;
+            size_t dst = static_cast<size_t>(rowOffset + i) * wordsPerRow + (colOffset >> 6);
+            int words = std::min(tile.wordsPerRow, wordsPerRow - (colOffset >> 6));
+            int lastBits = tile.cols & 63;
+            for (int w = 0; w < words; w++) {
+                uint64_t keep = 0;
+                if (w == tile.wordsPerRow - 1 && lastBits != 0) {
+                    keep = ~uint64_t(0) << lastBits;
+                }
+                rightWalls[dst + w] = (rightWalls[dst + w] & keep) | (tile.rightWalls[src + w] & ~keep);
+                bottomWalls[dst + w] = (bottomWalls[dst + w] & keep) | (tile.bottomWalls[src + w] & ~keep);
+            }
+        }
+        else {
+            for (int j = 0; j < tile.cols; j++) {
+                assignBit(rightWalls, bitIndex(rowOffset + i, colOffset + j), tile.hasRightWall(i, j));
+                assignBit(bottomWalls, bitIndex(rowOffset + i, colOffset + j), tile.hasBottomWall(i, j));
+            }
         }
     }
 }
 
+void Maze::setStart(int row, int col) {
+    if (!isValidCell(row, col)) {
+        throw std::out_of_range("Start coordinates out of range");
+    }
+    startIndex = cellIndex(row, col);
+}
+
+void Maze::setGoal(int row, int col) {
+    clearGoals();
+    addGoal(row, col);
+}
+
+void Maze::addGoal(int row, int col) {
+    if (!isValidCell(row, col)) {
+        throw std::out_of_range("Goal coordinates out of range");
+    }
+    if (isEndCell(row, col)) return;
+
+    assignBit(goalBits, bitIndex(row, col), true);
+    goalIndices.push_back(cellIndex(row, col));
+}
+
+void Maze::clearGoals() {
+    for (int goal : goalIndices) {
+        assignBit(goalBits, bitIndex(goal / cols, goal % cols), false);
+    }
+    goalIndices.clear();
+}
+
 bool Maze::isValidCell(int row, int col) const {
     return row >= 0 && row < rows && col >= 0 && col < cols;
 }
 
-void Maze::removeWall(Cell& current, Cell& next) {
+void Maze::removeWall(const Cell& current, const Cell& next) {
     int dr = next.row - current.row;
     int dc = next.col - current.col;
 
@@ -96,20 +210,16 @@ void Maze::removeWall(Cell& current, Cell& next) {
 
     
     if (dr == -1) {        
-        current.topWall = false;
-        next.bottomWall = false;
+        openBottomWall(next.row, next.col);
     }
     else if (dr == 1) {    
-        current.bottomWall = false;
-        next.topWall = false;
+        openBottomWall(current.row, current.col);
     }
     else if (dc == -1) {   
-        current.leftWall = false;
-        next.rightWall = false;
+        openRightWall(next.row, next.col);
     }
     else if (dc == 1) {    
-        current.rightWall = false;
-        next.leftWall = false;
+        openRightWall(current.row, current.col);
     }
 }
 
@@ -122,103 +232,77 @@ bool Maze::hasWallBetween(const Cell& cell1, const Cell& cell2) const {
         return true;
     }
 
-    if (dr == -1) return cell1.topWall;
-    if (dr == 1) return cell1.bottomWall;
-    if (dc == -1) return cell1.leftWall;
-    if (dc == 1) return cell1.rightWall;
+    if (dr == -1) return cell1.topWall();
+    if (dr == 1) return cell1.bottomWall();
+    if (dc == -1) return cell1.leftWall();
+    if (dc == 1) return cell1.rightWall();
 
     return true;
 }
 
-std::vector<Cell*> Maze::getUnvisitedNeighbors(Cell* cell) {
-    std::vector<Cell*> neighbors;
+unsigned Maze::unvisitedNeighborMask(int row, int col) const {
+    unsigned mask = 0;
+    if (row > 0 && !isVisited(row - 1, col)) mask |= 1u << DIR_UP;
+    if (row < rows - 1 && !isVisited(row + 1, col)) mask |= 1u << DIR_DOWN;
+    if (col > 0 && !isVisited(row, col - 1)) mask |= 1u << DIR_LEFT;
+    if (col < cols - 1 && !isVisited(row, col + 1)) mask |= 1u << DIR_RIGHT;
+    return mask;
+}
 
-    if (cell == nullptr) return neighbors;
+unsigned Maze::accessibleNeighborMask(int row, int col) const {
+    unsigned mask = 0;
+    if (row > 0 && !hasTopWall(row, col)) mask |= 1u << DIR_UP;
+    if (row < rows - 1 && !hasBottomWall(row, col)) mask |= 1u << DIR_DOWN;
+    if (col > 0 && !hasLeftWall(row, col)) mask |= 1u << DIR_LEFT;
+    if (col < cols - 1 && !hasRightWall(row, col)) mask |= 1u << DIR_RIGHT;
+    return mask;
+}
 
-    int row = cell->row;
-    int col = cell->col;
+std::vector<Cell> Maze::getUnvisitedNeighbors(const Cell& cell) {
+    std::vector<Cell> neighbors;
 
     // Comprobar en el orden: arriba, abajo, izquierda y derecha
-    if (isValidCell(row - 1, col) && !grid[row - 1][col].visited) {
-        neighbors.push_back(&grid[row - 1][col]);
-    }
-    if (isValidCell(row + 1, col) && !grid[row + 1][col].visited) {
-        neighbors.push_back(&grid[row + 1][col]);
-    }
-    if (isValidCell(row, col - 1) && !grid[row][col - 1].visited) {
-        neighbors.push_back(&grid[row][col - 1]);
-    }
-    if (isValidCell(row, col + 1) && !grid[row][col + 1].visited) {
-        neighbors.push_back(&grid[row][col + 1]);
-    }
+    forEachNeighbor(cell.row, cell.col, unvisitedNeighborMask(cell.row, cell.col),
+        [&](int r, int c, int) { neighbors.push_back(Cell(this, r, c)); });
 
     return neighbors;
 }
 
-std::vector<Cell*> Maze::getNeighbors(Cell* cell) {
-    std::vector<Cell*> neighbors;
-
-    if (cell == nullptr) return neighbors;
+std::vector<Cell> Maze::getNeighbors(const Cell& cell) {
+    std::vector<Cell> neighbors;
 
-    int row = cell->row;
-    int col = cell->col;
-
-    if (isValidCell(row - 1, col)) {
-        neighbors.push_back(&grid[row - 1][col]);
-    }
-    if (isValidCell(row + 1, col)) {
-        neighbors.push_back(&grid[row + 1][col]);
-    }
-    if (isValidCell(row, col - 1)) {
-        neighbors.push_back(&grid[row][col - 1]);
-    }
-    if (isValidCell(row, col + 1)) {
-        neighbors.push_back(&grid[row][col + 1]);
-    }
+    forEachNeighbor(cell.row, cell.col, neighborMask(cell.row, cell.col),
+        [&](int r, int c, int) { neighbors.push_back(Cell(this, r, c)); });
 
     return neighbors;
 }
 
-std::vector<Cell*> Maze::getAccessibleNeighbors(Cell* cell) {
-    std::vector<Cell*> neighbors;
-
-    if (cell == nullptr) return neighbors;
+std::vector<Cell> Maze::getAccessibleNeighbors(const Cell& cell) {
+    std::vector<Cell> neighbors;
 
-    int row = cell->row;
-    int col = cell->col;
-
-	// arriba
-    if (isValidCell(row - 1, col) && !cell->topWall) {
-        neighbors.push_back(&grid[row - 1][col]);
-    }
-    // abajo
-    if (isValidCell(row + 1, col) && !cell->bottomWall) {
-        neighbors.push_back(&grid[row + 1][col]);
-    }
-    // izq
-    if (isValidCell(row, col - 1) && !cell->leftWall) {
-        neighbors.push_back(&grid[row][col - 1]);
-    }
-    // derecha
-    if (isValidCell(row, col + 1) && !cell->rightWall) {
-        neighbors.push_back(&grid[row][col + 1]);
-    }
+    forEachNeighbor(cell.row, cell.col, accessibleNeighborMask(cell.row, cell.col),
+        [&](int r, int c, int) { neighbors.push_back(Cell(this, r, c)); });
 
     return neighbors;
 }
 
 int Maze::countWalls() const {
+    // Paredes interiores presentes en los planos (se ignoran los bits del borde y de relleno)
     int wallCount = 0;
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
-            const Cell& cell = grid[i][j];
-            if (cell.topWall) wallCount++;
-            if (cell.rightWall) wallCount++;
-            if (cell.bottomWall) wallCount++;
-            if (cell.leftWall) wallCount++;
+            if (j < cols - 1 && hasRightWall(i, j)) wallCount++;
+            if (i < rows - 1 && hasBottomWall(i, j)) wallCount++;
         }
     }
-    return wallCount / 2;  // Cada pared se cuenta dos veces, por lo tanto se divide entre 2
+    // Mismo criterio de antes: interiores + la mitad de las 2*(rows+cols) del borde
+    return wallCount + rows + cols;
+}
+
+size_t Maze::getMemoryBytes() const {
+    size_t words = rightWalls.size() + bottomWalls.size() + goalBits.size();
+    return sizeof(Maze) + words * sizeof(uint64_t) +
+        visitedStamps.size() + solutionStamps.size() + goalIndices.capacity() * sizeof(int);
 }
 
 void Maze::printDebugInfo() const {
@@ -226,7 +310,9 @@ void Maze::printDebugInfo() const {
     std::cout << "Dimensions: " << rows << "x" << cols << std::endl;
     std::cout << "Total cells: " << getTotalCells() << std::endl;
     std::cout << "Total walls: " << countWalls() << std::endl;
-    std::cout << "Start: (" << 0 << ", " << 0 << ")" << std::endl;
-    std::cout << "End: (" << rows - 1 << ", " << cols - 1 << ")" << std::endl;
+    std::cout << "Start: (" << getStartRow() << ", " << getStartCol() << ")" << std::endl;
+    for (int goal : goalIndices) {
+        std::cout << "End: (" << goal / cols << ", " << goal % cols << ")" << std::endl;
+    }
     std::cout << "======================\n" << std::endl;
 }
\ No newline at end of file
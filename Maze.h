@@ -2,86 +2,286 @@
 #define MAZE_H
 
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 
-struct Cell {
-    int row, col;
+class Maze;
+
+// Direcciones en el orden en que siempre se han recorrido las vecinas
+enum Direction {
+    DIR_UP = 0,
+    DIR_DOWN = 1,
+    DIR_LEFT = 2,
+    DIR_RIGHT = 3
+};
+
+const int DIR_DR[4] = { -1, 1, 0, 0 };
+const int DIR_DC[4] = { 0, 0, -1, 1 };
+
+inline int oppositeDirection(int dir) { return dir ^ 1; }
+
+// Lista de direcciones de capacidad fija construida a partir de una máscara
+// de 4 bits (bit 'dir' activo = vecina presente). No usa memoria dinámica.
+struct NeighborList {
+    int dirs[4];
+    int count;
+
+    explicit NeighborList(unsigned mask) : count(0) {
+        for (int dir = 0; dir < 4; dir++) {
+            if (mask & (1u << dir)) dirs[count++] = dir;
+        }
+    }
+};
 
-    // Paredes 
-    bool topWall;
-    bool rightWall;
-    bool bottomWall;
-    bool leftWall;
+// Vista ligera de una celda. No guarda paredes ni estados propios:
+// los consulta en los planos de bits del Maze al que pertenece.
+class Cell {
+private:
+    Maze* maze;
 
-    // Estados 
-    bool visited;      // Usado en los algoritmos de generación o exploración
-    bool inSolution;   // Indica si forma parte de la ruta óptima
-    bool isStart;      // Indica si es el punto de inicio
-    bool isEnd;        // Indica si es el punto final
+public:
+    int row, col;
 
+    Cell() : maze(nullptr), row(0), col(0) {
+    }
 
-    Cell() : row(0), col(0),
-        topWall(true), rightWall(true),
-        bottomWall(true), leftWall(true),
-        visited(false), inSolution(false),
-        isStart(false), isEnd(false) {
+    Cell(Maze* m, int r, int c) : maze(m), row(r), col(c) {
     }
 
+    // Paredes
+    bool topWall() const;
+    bool rightWall() const;
+    bool bottomWall() const;
+    bool leftWall() const;
+
+    // Estados
+    bool visited() const;       // Usado en los algoritmos de generación o exploración
+    bool inSolution() const;    // Indica si forma parte de la ruta óptima
+    bool isStart() const;       // Indica si es el punto de inicio
+    bool isEnd() const;         // Indica si es el punto final
+
+    void setVisited(bool value);
+    void setInSolution(bool value);
+
     // Verificar si todas las paredes están presentes (celda aislada)
     bool isFullyWalled() const {
-        return topWall && rightWall && bottomWall && leftWall;
+        return topWall() && rightWall() && bottomWall() && leftWall();
     }
 
     //  Verificar si hay una pared en una dirección específica
     bool hasWallInDirection(int dr, int dc) const {
-        if (dr == -1) return topWall;
-        if (dr == 1) return bottomWall;
-        if (dc == -1) return leftWall;
-        if (dc == 1) return rightWall;
+        if (dr == -1) return topWall();
+        if (dr == 1) return bottomWall();
+        if (dc == -1) return leftWall();
+        if (dc == 1) return rightWall();
         return true; // Dirección no válida
     }
+
+    bool operator==(const Cell& other) const {
+        return maze == other.maze && row == other.row && col == other.col;
+    }
+
+    bool operator!=(const Cell& other) const {
+        return !(*this == other);
+    }
 };
 
+// Almacenamiento plano: cada celda solo guarda su pared derecha e inferior
+// (la superior y la izquierda son las de la vecina), empaquetadas en palabras
+// de 64 bits. Cada fila ocupa 'wordsPerRow' palabras en todos los planos.
 class Maze {
 private:
     int rows;
     int cols;
-    std::vector<std::vector<Cell>> grid;
+    int wordsPerRow;
+
+    // Planos de paredes (bit a 1 = pared presente)
+    std::vector<uint64_t> rightWalls;
+    std::vector<uint64_t> bottomWalls;
+
+    // Estados 'visited' e 'inSolution' por época: una celda está marcada si su
+    // sello coincide con la época actual, así que limpiar es incrementar la época
+    std::vector<uint8_t> visitedStamps;
+    std::vector<uint8_t> solutionStamps;
+    uint8_t visitedEpoch;
+    uint8_t solutionEpoch;
+
+    // Registro de extremos: un inicio y cualquier número de metas.
+    // El plano 'goalBits' permite saber en O(1) si una celda es meta.
+    int startIndex;
+    std::vector<int> goalIndices;
+    std::vector<uint64_t> goalBits;
+
+    size_t bitIndex(int row, int col) const {
+        return static_cast<size_t>(row) * wordsPerRow * 64 + col;
+    }
+
+    static bool testBit(const std::vector<uint64_t>& plane, size_t bit) {
+        return ((plane[bit >> 6] >> (bit & 63)) & 1) != 0;
+    }
+
+    static void assignBit(std::vector<uint64_t>& plane, size_t bit, bool value) {
+        uint64_t mask = uint64_t(1) << (bit & 63);
+        if (value) plane[bit >> 6] |= mask;
+        else plane[bit >> 6] &= ~mask;
+    }
+
+    // Avanzar la época; solo al dar la vuelta hay que borrar todos los sellos
+    static void advanceEpoch(std::vector<uint8_t>& stamps, uint8_t& epoch);
 
 public:
+    // Límite de celdas (los ids de pared de 32 bits necesitan 2 por celda)
+    static const long long MAX_CELLS = 1LL << 30;
+
     Maze(int r, int c);
 
+    // Copiar duplica los planos; mover los traslada sin copiarlos (el origen
+    // queda vacío, de 0x0, y solo admite asignación o resize())
+    Maze(const Maze& other) = default;
+    Maze& operator=(const Maze& other) = default;
+    Maze(Maze&& other) noexcept;
+    Maze& operator=(Maze&& other) noexcept;
+
+    // Cambiar las dimensiones reutilizando la memoria ya reservada. Queda como
+    // recién construido: todas las paredes, sin marcas y extremos por defecto.
+    void resize(int r, int c);
+
     // Getters
     int getRows() const { return rows; }
     int getCols() const { return cols; }
+    int getWordsPerRow() const { return wordsPerRow; }
 
     // Acceso a celdas (versiones const y no const)
 
-    Cell& getCell(int row, int col);
-    const Cell& getCell(int row, int col) const;
+    Cell getCell(int row, int col);
+    const Cell getCell(int row, int col) const;
+
+    // Índice lineal de una celda (fila mayor)
+    int cellIndex(int row, int col) const { return row * cols + col; }
 
     // Inicialización y limpieza del laberinto
     void reset();               // Restaurar todas las paredes y reiniciar el estado
-    void clearVisited();        // Reiniciar solo la bandera 'visited'
-    void clearSolution();       // Reiniciar solo la bandera 'inSolution'
+    void clearVisited();        // Reiniciar solo la bandera 'visited' (O(1) amortizado)
+    void clearSolution();       // Reiniciar solo la bandera 'inSolution' (O(1) amortizado)
 
 
     // Validación
     bool isValidCell(int row, int col) const;
 
+    // Consulta directa de paredes (sin comprobación de límites)
+    bool hasTopWall(int row, int col) const {
+        return row == 0 || testBit(bottomWalls, bitIndex(row - 1, col));
+    }
+    bool hasRightWall(int row, int col) const {
+        return testBit(rightWalls, bitIndex(row, col));
+    }
+    bool hasBottomWall(int row, int col) const {
+        return testBit(bottomWalls, bitIndex(row, col));
+    }
+    bool hasLeftWall(int row, int col) const {
+        return col == 0 || testBit(rightWalls, bitIndex(row, col - 1));
+    }
+
+    // Apertura directa de paredes interiores (sin comprobación de límites)
+    void openRightWall(int row, int col) { assignBit(rightWalls, bitIndex(row, col), false); }
+    void openBottomWall(int row, int col) { assignBit(bottomWalls, bitIndex(row, col), false); }
+
+    // Copiar una fila completa de paredes (wordsPerRow palabras por plano)
+    void setWallRow(int row, const uint64_t* right, const uint64_t* bottom);
+
+    // Planos completos de paredes: getPlaneWords() palabras cada uno
+    size_t getPlaneWords() const { return rightWalls.size(); }
+    const uint64_t* getRightWallPlane() const { return rightWalls.data(); }
+    const uint64_t* getBottomWallPlane() const { return bottomWalls.data(); }
+    void setWallPlanes(const uint64_t* right, const uint64_t* bottom);
+
+    // Copiar las paredes de 'tile' en la región que empieza en (rowOffset, colOffset).
+    // Si colOffset es múltiplo de 64 se copian palabras completas.
+    void copyWallsFrom(const Maze& tile, int rowOffset, int colOffset);
+
+    // Paredes por dirección (sin comprobación de límites)
+    bool hasWall(int row, int col, int dir) const {
+        switch (dir) {
+        case DIR_UP: return hasTopWall(row, col);
+        case DIR_DOWN: return hasBottomWall(row, col);
+        case DIR_LEFT: return hasLeftWall(row, col);
+        default: return hasRightWall(row, col);
+        }
+    }
+    void openWall(int row, int col, int dir) {
+        switch (dir) {
+        case DIR_UP: openBottomWall(row - 1, col); break;
+        case DIR_DOWN: openBottomWall(row, col); break;
+        case DIR_LEFT: openRightWall(row, col - 1); break;
+        default: openRightWall(row, col); break;
+        }
+    }
+
+    // Consulta y modificación directa de estados
+    bool isVisited(int row, int col) const { return visitedStamps[cellIndex(row, col)] == visitedEpoch; }
+    bool isInSolution(int row, int col) const { return solutionStamps[cellIndex(row, col)] == solutionEpoch; }
+    bool isStartCell(int row, int col) const { return cellIndex(row, col) == startIndex; }
+    bool isEndCell(int row, int col) const { return testBit(goalBits, bitIndex(row, col)); }
+
+    void setVisited(int row, int col, bool value) { visitedStamps[cellIndex(row, col)] = value ? visitedEpoch : 0; }
+    void setInSolution(int row, int col, bool value) { solutionStamps[cellIndex(row, col)] = value ? solutionEpoch : 0; }
+
+    // Extremos (por defecto (0,0) y (rows-1, cols-1)); se conservan tras reset()
+    void setStart(int row, int col);
+    void setGoal(int row, int col);      // Reemplaza todas las metas por una sola
+    void addGoal(int row, int col);
+    void clearGoals();
+    int getStartIndex() const { return startIndex; }
+    int getStartRow() const { return startIndex / cols; }
+    int getStartCol() const { return startIndex % cols; }
+    const std::vector<int>& getGoals() const { return goalIndices; }
+
     // Manipulación de paredes
-    void removeWall(Cell& current, Cell& next);
+    void removeWall(const Cell& current, const Cell& next);
     bool hasWallBetween(const Cell& cell1, const Cell& cell2) const;
 
+    // Vecinas como máscara de 4 bits (sin memoria dinámica)
+    unsigned neighborMask(int row, int col) const {
+        return (row > 0 ? 1u << DIR_UP : 0u) | (row < rows - 1 ? 1u << DIR_DOWN : 0u) |
+            (col > 0 ? 1u << DIR_LEFT : 0u) | (col < cols - 1 ? 1u << DIR_RIGHT : 0u);
+    }
+    unsigned unvisitedNeighborMask(int row, int col) const;
+    unsigned accessibleNeighborMask(int row, int col) const;
+
+    // Llamar a visit(fila, columna, dirección) por cada vecina presente en la máscara
+    template <typename Visitor>
+    void forEachNeighbor(int row, int col, unsigned mask, Visitor visit) const {
+        for (int dir = 0; dir < 4; dir++) {
+            if (mask & (1u << dir)) {
+                visit(row + DIR_DR[dir], col + DIR_DC[dir], dir);
+            }
+        }
+    }
+
     // Búsqueda de celdas vecinas
-    std::vector<Cell*> getUnvisitedNeighbors(Cell* cell);
-    std::vector<Cell*> getNeighbors(Cell* cell);              // Sin importar si fueron visitadas
-    std::vector<Cell*> getAccessibleNeighbors(Cell* cell);    // Solo vecinas sin paredes
+    std::vector<Cell> getUnvisitedNeighbors(const Cell& cell);
+    std::vector<Cell> getNeighbors(const Cell& cell);              // Sin importar si fueron visitadas
+    std::vector<Cell> getAccessibleNeighbors(const Cell& cell);    // Solo vecinas sin paredes
 
     // Depuración y estadísticas
     int getTotalCells() const { return rows * cols; }
     int countWalls() const;
+    size_t getMemoryBytes() const;
     void printDebugInfo() const;
 
 };
 
-#endif
\ No newline at end of file
+inline bool Cell::topWall() const { return maze->hasTopWall(row, col); }
+inline bool Cell::rightWall() const { return maze->hasRightWall(row, col); }
+inline bool Cell::bottomWall() const { return maze->hasBottomWall(row, col); }
+inline bool Cell::leftWall() const { return maze->hasLeftWall(row, col); }
+
+inline bool Cell::visited() const { return maze->isVisited(row, col); }
+inline bool Cell::inSolution() const { return maze->isInSolution(row, col); }
+inline bool Cell::isStart() const { return maze->isStartCell(row, col); }
+inline bool Cell::isEnd() const { return maze->isEndCell(row, col); }
+
+inline void Cell::setVisited(bool value) { maze->setVisited(row, col, value); }
+inline void Cell::setInSolution(bool value) { maze->setInSolution(row, col, value); }
+
+#endif
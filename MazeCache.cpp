@@ -0,0 +1,107 @@
+﻿#include "MazeCache.h"
+
+MazeCache::MazeCache(size_t budgetBytes) : byteBudget(budgetBytes), usedBytes(0), hits(0), misses(0) {
+}
+
+bool MazeCache::lookup(const MazeCacheKey& key, Maze& maze, SolveResult& solution) {
+    auto found = index.find(key);
+    if (found == index.end() || maze.getRows() != key.rows || maze.getCols() != key.cols) {
+        misses++;
+        return false;
+    }
+
+    Entry& entry = *found->second;
+    if (maze.getStartIndex() != entry.startIndex || maze.getGoals() != entry.goals) {
+        misses++;
+        return false;
+    }
+
+    // Pasar al frente de la lista (más reciente)
+    entries.splice(entries.begin(), entries, found->second);
+
+    maze.setWallPlanes(entry.rightWalls.data(), entry.bottomWalls.data());
+    maze.clearVisited();
+    maze.clearSolution();
+
+    int cols = maze.getCols();
+    for (int cell : entry.solution.path) {
+        maze.setInSolution(cell / cols, cell % cols, true);
+    }
+    solution = entry.solution;
+
+    hits++;
+    return true;
+}
+
+void MazeCache::store(const MazeCacheKey& key, const Maze& maze, const SolveResult& solution) {
+    if (maze.getRows() != key.rows || maze.getCols() != key.cols) {
+        return;
+    }
+
+    auto found = index.find(key);
+    if (found != index.end()) {
+        usedBytes -= found->second->bytes;
+        entries.erase(found->second);
+        index.erase(found);
+    }
+
+    Entry entry(key);
+    size_t words = maze.getPlaneWords();
+    entry.rightWalls.assign(maze.getRightWallPlane(), maze.getRightWallPlane() + words);
+    entry.bottomWalls.assign(maze.getBottomWallPlane(), maze.getBottomWallPlane() + words);
+    entry.startIndex = maze.getStartIndex();
+    entry.goals = maze.getGoals();
+    entry.solution = solution;
+    entry.solution.path.shrink_to_fit();
+    entry.bytes = sizeof(Entry) + 2 * words * sizeof(uint64_t) +
+        (entry.goals.size() + entry.solution.path.size()) * sizeof(int);
+
+    // Una entrada que no cabe sola en el presupuesto no se guarda
+    if (entry.bytes > byteBudget) {
+        return;
+    }
+
+    entries.push_front(std::move(entry));
+    index.insert(std::make_pair(key, entries.begin()));
+    usedBytes += entries.front().bytes;
+
+    evictToBudget();
+}
+
+bool MazeCache::fetchOrGenerate(Maze& maze, MazeGenerator& generator, MazeSolver& solver,
+    MazeAlgorithm algorithm, unsigned int seed) {
+    MazeCacheKey key(maze.getRows(), maze.getCols(), algorithm, seed,
+        generator.getLegacyPrims(), generator.getStacklessBacktracker());
+
+    SolveResult cached;
+    if (lookup(key, maze, cached)) {
+        solver.adoptResult(cached);
+        return true;
+    }
+
+    bool useTree = recordTreePaysOff(algorithm);
+    generator.setRecordTree(useTree);
+    generator.generateWithSeed(seed, algorithm);
+    store(key, maze, useTree ? solver.solveFromTree(generator.getSpanningTree()) : solver.solveBFS());
+    return false;
+}
+
+void MazeCache::evictToBudget() {
+    while (usedBytes > byteBudget && !entries.empty()) {
+        Entry& oldest = entries.back();
+        usedBytes -= oldest.bytes;
+        index.erase(oldest.key);
+        entries.pop_back();
+    }
+}
+
+void MazeCache::clear() {
+    entries.clear();
+    index.clear();
+    usedBytes = 0;
+}
+
+void MazeCache::setByteBudget(size_t budgetBytes) {
+    byteBudget = budgetBytes;
+    evictToBudget();
+}
@@ -0,0 +1,95 @@
+﻿#ifndef MAZE_CACHE_H
+#define MAZE_CACHE_H
+
+#include "Maze.h"
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include <list>
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Clave de un laberinto reproducible (generador por defecto, std::mt19937).
+// Incluye las opciones del generador que cambian el laberinto de una semilla.
+struct MazeCacheKey {
+    int rows;
+    int cols;
+    MazeAlgorithm algorithm;
+    unsigned int seed;
+    bool legacyPrims;
+    bool stacklessBacktracker;
+
+    MazeCacheKey(int r, int c, MazeAlgorithm a, unsigned int s, bool legacy = false, bool stackless = false)
+        : rows(r), cols(c), algorithm(a), seed(s), legacyPrims(legacy), stacklessBacktracker(stackless) {
+    }
+
+    bool operator<(const MazeCacheKey& other) const {
+        if (rows != other.rows) return rows < other.rows;
+        if (cols != other.cols) return cols < other.cols;
+        if (algorithm != other.algorithm) return algorithm < other.algorithm;
+        if (seed != other.seed) return seed < other.seed;
+        if (legacyPrims != other.legacyPrims) return legacyPrims < other.legacyPrims;
+        return stacklessBacktracker < other.stacklessBacktracker;
+    }
+};
+
+// Caché de laberintos ya generados y resueltos. Guarda los planos de paredes
+// y el camino solución; recuperar uno es copiar memoria en lugar de generar
+// y resolver. Se expulsa el menos usado (LRU) al pasar del presupuesto.
+class MazeCache {
+private:
+    struct Entry {
+        MazeCacheKey key;
+        std::vector<uint64_t> rightWalls;
+        std::vector<uint64_t> bottomWalls;
+        int startIndex;                 // Extremos con los que se resolvió
+        std::vector<int> goals;
+        SolveResult solution;
+        size_t bytes;
+
+        explicit Entry(const MazeCacheKey& k) : key(k), startIndex(0), bytes(0) {
+        }
+    };
+
+    // Más reciente al principio
+    std::list<Entry> entries;
+    std::map<MazeCacheKey, std::list<Entry>::iterator> index;
+
+    size_t byteBudget;
+    size_t usedBytes;
+    long long hits;
+    long long misses;
+
+    void evictToBudget();
+
+public:
+    explicit MazeCache(size_t budgetBytes);
+
+    // Copiar en 'maze' el laberinto de 'key' y dejar su solución en 'solution'
+    // (marcando 'inSolution'). Falla si no está o si 'maze' no tiene las
+    // mismas dimensiones y extremos.
+    bool lookup(const MazeCacheKey& key, Maze& maze, SolveResult& solution);
+
+    // Guardar 'maze' y su solución bajo 'key'
+    void store(const MazeCacheKey& key, const Maze& maze, const SolveResult& solution);
+
+    // Recuperar de la caché o, si no está, generar con 'generator' y resolver
+    // con 'solver' (ambos sobre 'maze') y guardarlo. La clave toma las
+    // opciones actuales de 'generator'; el registro del árbol se ajusta según
+    // recordTreePaysOff(). Devuelve true si hubo acierto.
+    bool fetchOrGenerate(Maze& maze, MazeGenerator& generator, MazeSolver& solver,
+        MazeAlgorithm algorithm, unsigned int seed);
+
+    void clear();
+    void setByteBudget(size_t budgetBytes);
+
+    // Estadísticas
+    size_t getByteBudget() const { return byteBudget; }
+    size_t getUsedBytes() const { return usedBytes; }
+    int getEntryCount() const { return static_cast<int>(entries.size()); }
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+};
+
+#endif
@@ -0,0 +1,239 @@
+﻿#include "MazeFile.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static uint64_t alignToPage(uint64_t offset) {
+    return (offset + MAZE_FILE_PAGE_SIZE - 1) / MAZE_FILE_PAGE_SIZE * MAZE_FILE_PAGE_SIZE;
+}
+
+// Rellenar con ceros hasta 'offset'
+static void padTo(std::ofstream& file, uint64_t offset) {
+    static const char zeros[MAZE_FILE_PAGE_SIZE] = {};
+    uint64_t position = static_cast<uint64_t>(file.tellp());
+    while (position < offset) {
+        uint64_t chunk = std::min<uint64_t>(offset - position, MAZE_FILE_PAGE_SIZE);
+        file.write(zeros, static_cast<std::streamsize>(chunk));
+        position += chunk;
+    }
+}
+
+bool saveMazeFile(const std::string& filename, const Maze& maze, MazeAlgorithm algorithm,
+    unsigned int seed, const SolveResult* solution) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file for writing: " << filename << std::endl;
+        return false;
+    }
+
+    bool withSolution = solution != nullptr && solution->found;
+    const std::vector<int>& goals = maze.getGoals();
+
+    MazeFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "MZBF", 4);
+    header.version = MAZE_FILE_VERSION;
+    header.headerBytes = sizeof(MazeFileHeader);
+    header.flags = withSolution ? MAZE_FILE_HAS_SOLUTION : 0;
+    header.rows = maze.getRows();
+    header.cols = maze.getCols();
+    header.wordsPerRow = maze.getWordsPerRow();
+    header.algorithm = algorithm;
+    header.seed = seed;
+    header.startIndex = maze.getStartIndex();
+    header.goalCount = static_cast<int32_t>(goals.size());
+    header.solutionLength = withSolution ? static_cast<int32_t>(solution->path.size()) : 0;
+    header.planeBytes = maze.getPlaneWords() * sizeof(uint64_t);
+    header.rightOffset = alignToPage(sizeof(MazeFileHeader));
+    header.bottomOffset = alignToPage(header.rightOffset + header.planeBytes);
+    header.goalsOffset = header.bottomOffset + header.planeBytes;
+    header.solutionOffset = header.goalsOffset + static_cast<uint64_t>(header.goalCount) * sizeof(int32_t);
+    header.fileBytes = header.solutionOffset + static_cast<uint64_t>(header.solutionLength) * sizeof(int32_t);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    padTo(file, header.rightOffset);
+    file.write(reinterpret_cast<const char*>(maze.getRightWallPlane()),
+        static_cast<std::streamsize>(header.planeBytes));
+
+    padTo(file, header.bottomOffset);
+    file.write(reinterpret_cast<const char*>(maze.getBottomWallPlane()),
+        static_cast<std::streamsize>(header.planeBytes));
+
+    for (int goal : goals) {
+        int32_t value = goal;
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    if (withSolution) {
+        for (int cell : solution->path) {
+            int32_t value = cell;
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    if (!file.good()) {
+        std::cerr << "Error: Failed while writing maze file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#ifdef _WIN32
+MappedMaze::MappedMaze() : data(nullptr), size(0), header(nullptr), rightWalls(nullptr),
+    bottomWalls(nullptr), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+}
+#else
+MappedMaze::MappedMaze() : data(nullptr), size(0), header(nullptr), rightWalls(nullptr),
+    bottomWalls(nullptr), fileDescriptor(-1) {
+}
+#endif
+
+MappedMaze::~MappedMaze() {
+    close();
+}
+
+bool MappedMaze::mapFile(const std::string& filename) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return false;
+    size = static_cast<size_t>(fileSize.QuadPart);
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) return false;
+    mappingHandle = mapping;
+
+    data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    return data != nullptr;
+#else
+    fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) return false;
+
+    struct stat info;
+    if (fstat(fileDescriptor, &info) != 0 || info.st_size == 0) return false;
+    size = static_cast<size_t>(info.st_size);
+
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    if (mapped == MAP_FAILED) return false;
+    data = static_cast<const unsigned char*>(mapped);
+    return true;
+#endif
+}
+
+void MappedMaze::unmapFile() {
+#ifdef _WIN32
+    if (data != nullptr) UnmapViewOfFile(data);
+    if (mappingHandle != nullptr) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (data != nullptr) munmap(const_cast<unsigned char*>(data), size);
+    if (fileDescriptor >= 0) ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+bool MappedMaze::open(const std::string& filename) {
+    close();
+
+    if (!mapFile(filename)) {
+        std::cerr << "Error: Could not map maze file: " << filename << std::endl;
+        unmapFile();
+        return false;
+    }
+
+    // Validar la cabecera y que todas las secciones caben en el archivo
+    const MazeFileHeader* candidate = reinterpret_cast<const MazeFileHeader*>(data);
+    bool valid = size >= sizeof(MazeFileHeader) &&
+        std::memcmp(candidate->magic, "MZBF", 4) == 0 &&
+        candidate->version == MAZE_FILE_VERSION &&
+        candidate->headerBytes == sizeof(MazeFileHeader) &&
+        candidate->rows > 0 && candidate->cols > 0 &&
+        static_cast<long long>(candidate->rows) * candidate->cols <= Maze::MAX_CELLS &&
+        candidate->wordsPerRow == (candidate->cols + 63) / 64 &&
+        candidate->startIndex >= 0 &&
+        static_cast<long long>(candidate->startIndex) < static_cast<long long>(candidate->rows) * candidate->cols &&
+        candidate->planeBytes == static_cast<uint64_t>(candidate->rows) * candidate->wordsPerRow * sizeof(uint64_t) &&
+        candidate->rightOffset % MAZE_FILE_PAGE_SIZE == 0 &&
+        candidate->bottomOffset % MAZE_FILE_PAGE_SIZE == 0 &&
+        candidate->rightOffset + candidate->planeBytes <= candidate->bottomOffset &&
+        candidate->goalCount >= 0 && candidate->solutionLength >= 0 &&
+        candidate->goalsOffset % sizeof(int32_t) == 0 &&
+        candidate->goalsOffset >= candidate->bottomOffset + candidate->planeBytes &&
+        candidate->solutionOffset >= candidate->goalsOffset + static_cast<uint64_t>(candidate->goalCount) * sizeof(int32_t) &&
+        candidate->solutionOffset % sizeof(int32_t) == 0 &&
+        candidate->fileBytes >= candidate->solutionOffset + static_cast<uint64_t>(candidate->solutionLength) * sizeof(int32_t) &&
+        candidate->fileBytes <= size;
+
+    if (!valid) {
+        std::cerr << "Error: Invalid or unsupported maze file: " << filename << std::endl;
+        unmapFile();
+        return false;
+    }
+
+    header = candidate;
+    rightWalls = reinterpret_cast<const uint64_t*>(data + header->rightOffset);
+    bottomWalls = reinterpret_cast<const uint64_t*>(data + header->bottomOffset);
+    return true;
+}
+
+void MappedMaze::close() {
+    header = nullptr;
+    rightWalls = nullptr;
+    bottomWalls = nullptr;
+    unmapFile();
+}
+
+const int32_t* MappedMaze::getGoals() const {
+    return reinterpret_cast<const int32_t*>(data + header->goalsOffset);
+}
+
+const int32_t* MappedMaze::getSolution() const {
+    return reinterpret_cast<const int32_t*>(data + header->solutionOffset);
+}
+
+bool MappedMaze::copyTo(Maze& maze) const {
+    if (!isOpen() || maze.getRows() != header->rows || maze.getCols() != header->cols) {
+        std::cerr << "Error: Maze dimensions do not match the mapped file" << std::endl;
+        return false;
+    }
+
+    int cols = header->cols;
+    const int32_t* goals = getGoals();
+    for (int i = 0; i < header->goalCount; i++) {
+        if (goals[i] < 0 || goals[i] >= maze.getTotalCells()) {
+            std::cerr << "Error: Goal out of range in mapped maze file" << std::endl;
+            return false;
+        }
+    }
+
+    maze.setWallPlanes(rightWalls, bottomWalls);
+
+    maze.setStart(header->startIndex / cols, header->startIndex % cols);
+    maze.clearGoals();
+    for (int i = 0; i < header->goalCount; i++) {
+        maze.addGoal(goals[i] / cols, goals[i] % cols);
+    }
+    return true;
+}
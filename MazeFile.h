@@ -0,0 +1,121 @@
+﻿#ifndef MAZE_FILE_H
+#define MAZE_FILE_H
+
+#include "Maze.h"
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Formato binario de laberinto (little-endian), versión 1:
+//   [0]               cabecera MazeFileHeader
+//   [rightOffset]     plano de paredes derechas, rows * wordsPerRow palabras
+//   [bottomOffset]    plano de paredes inferiores, mismo tamaño
+//   [goalsOffset]     metas (int32, índices de celda)
+//   [solutionOffset]  camino solución opcional (int32, del inicio a la meta)
+// Los planos empiezan en múltiplos de MAZE_FILE_PAGE_SIZE, así se pueden
+// consultar directamente desde la memoria mapeada.
+const uint32_t MAZE_FILE_VERSION = 1;
+const uint64_t MAZE_FILE_PAGE_SIZE = 4096;
+
+struct MazeFileHeader {
+    char magic[4];              // "MZBF"
+    uint32_t version;
+    uint32_t headerBytes;
+    uint32_t flags;             // MAZE_FILE_HAS_SOLUTION
+    int32_t rows;
+    int32_t cols;
+    int32_t wordsPerRow;
+    int32_t algorithm;
+    uint32_t seed;
+    int32_t startIndex;
+    int32_t goalCount;
+    int32_t solutionLength;
+    uint64_t rightOffset;
+    uint64_t bottomOffset;
+    uint64_t planeBytes;
+    uint64_t goalsOffset;
+    uint64_t solutionOffset;
+    uint64_t fileBytes;
+};
+
+const uint32_t MAZE_FILE_HAS_SOLUTION = 1;
+
+// Guardar un laberinto con su algoritmo y semilla; 'solution' puede ser nulo
+bool saveMazeFile(const std::string& filename, const Maze& maze, MazeAlgorithm algorithm,
+    unsigned int seed, const SolveResult* solution = nullptr);
+
+// Laberinto de solo lectura abierto desde un archivo mapeado en memoria.
+// Abrir solo valida la cabecera; las paredes se consultan en el propio
+// archivo sin copiarlas (el sistema carga las páginas al tocarlas).
+class MappedMaze {
+private:
+    const unsigned char* data;
+    size_t size;
+    const MazeFileHeader* header;
+    const uint64_t* rightWalls;
+    const uint64_t* bottomWalls;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+    size_t bitIndex(int row, int col) const {
+        return static_cast<size_t>(row) * header->wordsPerRow * 64 + col;
+    }
+
+    static bool testBit(const uint64_t* plane, size_t bit) {
+        return ((plane[bit >> 6] >> (bit & 63)) & 1) != 0;
+    }
+
+    bool mapFile(const std::string& filename);
+    void unmapFile();
+
+public:
+    MappedMaze();
+    ~MappedMaze();
+
+    MappedMaze(const MappedMaze&) = delete;
+    MappedMaze& operator=(const MappedMaze&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Cabecera
+    int getRows() const { return header->rows; }
+    int getCols() const { return header->cols; }
+    MazeAlgorithm getAlgorithm() const { return static_cast<MazeAlgorithm>(header->algorithm); }
+    unsigned int getSeed() const { return header->seed; }
+    int getStartIndex() const { return header->startIndex; }
+    int getGoalCount() const { return header->goalCount; }
+    const int32_t* getGoals() const;
+
+    // Solución opcional
+    bool hasSolution() const { return (header->flags & MAZE_FILE_HAS_SOLUTION) != 0; }
+    int getSolutionLength() const { return header->solutionLength; }
+    const int32_t* getSolution() const;
+
+    // Consulta de paredes en el archivo (sin comprobación de límites)
+    bool hasTopWall(int row, int col) const {
+        return row == 0 || testBit(bottomWalls, bitIndex(row - 1, col));
+    }
+    bool hasRightWall(int row, int col) const {
+        return testBit(rightWalls, bitIndex(row, col));
+    }
+    bool hasBottomWall(int row, int col) const {
+        return testBit(bottomWalls, bitIndex(row, col));
+    }
+    bool hasLeftWall(int row, int col) const {
+        return col == 0 || testBit(rightWalls, bitIndex(row, col - 1));
+    }
+
+    // Copiar paredes y extremos a un Maze de las mismas dimensiones
+    bool copyTo(Maze& maze) const;
+};
+
+#endif
@@ -3,11 +3,18 @@
 #include <allegro5/allegro_font.h>
 #include <allegro5/allegro_ttf.h>
 #include <time.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
 #include <vector>
+#include <random>
 #include "Config.h"
 #include "Maze.h"
 #include "MazeGenerator.h"
 #include "MazeSolver.h"
+#include "ParallelBFS.h"
+#include "GameSession.h"
+#include "MazeCache.h"
 #include "Player.h"
 #include "Statistics.h"
 #include <allegro5/allegro_audio.h>      
@@ -76,6 +83,11 @@ const int NUM_MENU_ITEMS = 5;
 int CURRENT_WIDTH = 1920;
 int CURRENT_HEIGHT = 1080;
 
+// La demo elige al azar entre unas pocas semillas fijas: varía entre
+// partidas y, al repetirse, sale de la caché sin generar ni resolver
+const int NUM_DEMO_SEEDS = 8;
+const size_t MAZE_CACHE_BYTES = 4 * 1024 * 1024;
+
 struct DemoState {
     std::vector<std::pair<int, int>> path;
     int currentStep;
@@ -83,97 +95,15 @@ struct DemoState {
     bool isPlaying;
 };
 
-int countSolutionLength(Maze& maze) {
-    int count = 0;
-    for (int i = 0; i < maze.getRows(); i++) {
-        for (int j = 0; j < maze.getCols(); j++) {
-            if (maze.getCell(i, j).inSolution) {
-                count++;
-            }
-        }
-    }
-    return count;
-}
-
-void buildDemoPath(Maze& maze, std::vector<std::pair<int, int>>& path) {
+// El camino de la demo sale de la misma resolución BFS que usa el juego
+void buildDemoPath(const Maze& maze, const SolveResult& result,
+    std::vector<std::pair<int, int>>& path) {
     path.clear();
+    path.reserve(result.path.size());
 
-    int startRow = -1, startCol = -1;
-    for (int i = 0; i < maze.getRows(); i++) {
-        for (int j = 0; j < maze.getCols(); j++) {
-            if (maze.getCell(i, j).isStart) {
-                startRow = i;
-                startCol = j;
-                break;
-            }
-        }
-        if (startRow != -1) break;
-    }
-
-    std::vector<std::vector<bool>> visited(maze.getRows(),
-        std::vector<bool>(maze.getCols(), false));
-    std::vector<std::pair<int, int>> queue;
-    std::vector<std::vector<std::pair<int, int>>> parent(maze.getRows(),
-        std::vector<std::pair<int, int>>(maze.getCols(), { -1, -1 }));
-
-    queue.push_back({ startRow, startCol });
-    visited[startRow][startCol] = true;
-
-    int endRow = -1, endCol = -1;
-
-    while (!queue.empty()) {
-        auto current = queue.front();
-        queue.erase(queue.begin());
-
-        int row = current.first;
-        int col = current.second;
-
-        if (maze.getCell(row, col).isEnd) {
-            endRow = row;
-            endCol = col;
-            break;
-        }
-
-        int dr[] = { -1, 1, 0, 0 };
-        int dc[] = { 0, 0, -1, 1 };
-
-        for (int i = 0; i < 4; i++) {
-            int newRow = row + dr[i];
-            int newCol = col + dc[i];
-
-            if (newRow >= 0 && newRow < maze.getRows() &&
-                newCol >= 0 && newCol < maze.getCols() &&
-                !visited[newRow][newCol]) {
-
-                bool canMove = false;
-                if (i == 0 && !maze.getCell(row, col).topWall) canMove = true;
-                if (i == 1 && !maze.getCell(row, col).bottomWall) canMove = true;
-                if (i == 2 && !maze.getCell(row, col).leftWall) canMove = true;
-                if (i == 3 && !maze.getCell(row, col).rightWall) canMove = true;
-
-                if (canMove) {
-                    visited[newRow][newCol] = true;
-                    parent[newRow][newCol] = { row, col };
-                    queue.push_back({ newRow, newCol });
-                }
-            }
-        }
-    }
-
-    if (endRow != -1) {
-        std::vector<std::pair<int, int>> reversePath;
-        int r = endRow, c = endCol;
-
-        while (r != -1 && c != -1) {
-            reversePath.push_back({ r, c });
-            auto p = parent[r][c];
-            r = p.first;
-            c = p.second;
-        }
-
-        for (int i = reversePath.size() - 1; i >= 0; i--) {
-            path.push_back(reversePath[i]);
-        }
+    int cols = maze.getCols();
+    for (int cell : result.path) {
+        path.push_back({ cell / cols, cell % cols });
     }
 }
 
@@ -507,7 +437,30 @@ void toggleMusic() {
         al_play_sample_instance(musicInstance);
     }
 }
-int main() {
+// Medición sin interfaz: MazeGame --bench-bfs [filas columnas hilos]
+int runParallelBFSBenchmark(int argc, char** argv) {
+    int rows = argc > 2 ? atoi(argv[2]) : 4000;
+    int cols = argc > 3 ? atoi(argv[3]) : 4000;
+    int threads = argc > 4 ? atoi(argv[4]) : 0;
+
+    try {
+        Maze maze(rows, cols);
+        FastMazeGenerator generator(&maze);
+        generator.generateParallelWithSeed(1, KRUSKALS, threads);
+        ParallelBFS::benchmark(maze, 0, threads, 3);
+    }
+    catch (const std::exception& e) {
+        printf("Error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--bench-bfs") == 0) {
+        return runParallelBFSBenchmark(argc, argv);
+    }
+
     al_init();
     al_init_primitives_addon();
     al_init_font_addon();
@@ -596,12 +549,18 @@ int main() {
     al_register_event_source(queue, al_get_display_event_source(display));
     al_register_event_source(queue, al_get_keyboard_event_source());
 
-    Maze maze(MAZE_ROWS, MAZE_COLS);
-    MazeGenerator generator(&maze);
-    MazeSolver solver(&maze);
-    Player player(&maze);
+    // La sesión es dueña del laberinto y de todo lo que apunta a él
+    GameSession session(MAZE_ROWS, MAZE_COLS);
+    Maze& maze = session.getMaze();
+    MazeGenerator& generator = session.getGenerator();
+    MazeSolver& solver = session.getSolver();
+    Player& player = session.getPlayer();
     Statistics stats("maze_stats.csv");
 
+    MazeCache mazeCache(MAZE_CACHE_BYTES);
+    std::mt19937 demoPicker(std::random_device{}());
+    std::uniform_int_distribution<unsigned int> demoSeeds(1, NUM_DEMO_SEEDS);
+
     GameState state = MENU_PRINCIPAL;
     int selectedMenuItem = 0;
     int selectedDifficulty = 1;
@@ -617,6 +576,9 @@ int main() {
     demoState.currentStep = 0;
     demoState.lastMoveTime = 0;
 
+    session.prepare(difficulties[selectedDifficulty].rows, difficulties[selectedDifficulty].cols,
+        algorithmItems[selectedAlgorithm].algorithm);
+
     printf("\n=== MAZE EXPLORER ===\n");
     printf("Sistema de menus iniciado\n\n");
 
@@ -705,33 +667,33 @@ int main() {
 
             for (int i = 0; i < maze.getRows(); i++) {
                 for (int j = 0; j < maze.getCols(); j++) {
-                    Cell& cell = maze.getCell(i, j);
+                    Cell cell = maze.getCell(i, j);
                     int x = offsetX + (j * cellSize);
                     int y = offsetY + (i * cellSize);
 
-                    if (cell.isStart) {
+                    if (cell.isStart()) {
                         al_draw_filled_rectangle(x, y, x + cellSize, y + cellSize,
                             al_map_rgb(COLOR_START.r, COLOR_START.g, COLOR_START.b));
                     }
 
-                    if (cell.isEnd) {
+                    if (cell.isEnd()) {
                         al_draw_filled_rectangle(x, y, x + cellSize, y + cellSize,
                             al_map_rgb(COLOR_END.r, COLOR_END.g, COLOR_END.b));
                     }
 
-                    if (cell.topWall) {
+                    if (cell.topWall()) {
                         al_draw_line(x, y, x + cellSize, y,
                             al_map_rgb(COLOR_WALL.r, COLOR_WALL.g, COLOR_WALL.b), 2);
                     }
-                    if (cell.rightWall) {
+                    if (cell.rightWall()) {
                         al_draw_line(x + cellSize, y, x + cellSize, y + cellSize,
                             al_map_rgb(COLOR_WALL.r, COLOR_WALL.g, COLOR_WALL.b), 2);
                     }
-                    if (cell.bottomWall) {
+                    if (cell.bottomWall()) {
                         al_draw_line(x, y + cellSize, x + cellSize, y + cellSize,
                             al_map_rgb(COLOR_WALL.r, COLOR_WALL.g, COLOR_WALL.b), 2);
                     }
-                    if (cell.leftWall) {
+                    if (cell.leftWall()) {
                         al_draw_line(x, y, x, y + cellSize,
                             al_map_rgb(COLOR_WALL.r, COLOR_WALL.g, COLOR_WALL.b), 2);
                     }
@@ -791,38 +753,38 @@ int main() {
 
             for (int i = 0; i < maze.getRows(); i++) {
                 for (int j = 0; j < maze.getCols(); j++) {
-                    Cell& cell = maze.getCell(i, j);
+                    Cell cell = maze.getCell(i, j);
                     int x = offsetX + (j * cellSize);
                     int y = offsetY + (i * cellSize);
 
-                    if (showSolution && cell.inSolution && !cell.isStart && !cell.isEnd) {
+                    if (showSolution && cell.inSolution() && !cell.isStart() && !cell.isEnd()) {
                         al_draw_filled_rectangle(x + 5, y + 5, x + cellSize - 5, y + cellSize - 5,
                             al_map_rgb(COLOR_SOLUTION.r, COLOR_SOLUTION.g, COLOR_SOLUTION.b));
                     }
 
-                    if (cell.isStart) {
+                    if (cell.isStart()) {
                         al_draw_filled_rectangle(x, y, x + cellSize, y + cellSize,
                             al_map_rgb(COLOR_START.r, COLOR_START.g, COLOR_START.b));
                     }
 
-                    if (cell.isEnd) {
+                    if (cell.isEnd()) {
                         al_draw_filled_rectangle(x, y, x + cellSize, y + cellSize,
                             al_map_rgb(COLOR_END.r, COLOR_END.g, COLOR_END.b));
                     }
 
-                    if (cell.topWall) {
+                    if (cell.topWall()) {
                         al_draw_line(x, y, x + cellSize, y,
                             al_map_rgb(COLOR_WALL.r, COLOR_WALL.g, COLOR_WALL.b), 2);
                     }
-                    if (cell.rightWall) {
+                    if (cell.rightWall()) {
                         al_draw_line(x + cellSize, y, x + cellSize, y + cellSize,
                             al_map_rgb(COLOR_WALL.r, COLOR_WALL.g, COLOR_WALL.b), 2);
                     }
-                    if (cell.bottomWall) {
+                    if (cell.bottomWall()) {
                         al_draw_line(x, y + cellSize, x + cellSize, y + cellSize,
                             al_map_rgb(COLOR_WALL.r, COLOR_WALL.g, COLOR_WALL.b), 2);
                     }
-                    if (cell.leftWall) {
+                    if (cell.leftWall()) {
                         al_draw_line(x, y, x, y + cellSize,
                             al_map_rgb(COLOR_WALL.r, COLOR_WALL.g, COLOR_WALL.b), 2);
                     }
@@ -884,14 +846,13 @@ int main() {
                             state = SELECCION_DIFICULTAD;
                         }
                         else if (selectedMenuItem == 1) {
-                            generator.generate(PRIMS);
-                            solver.solveBFS();
+                            mazeCache.fetchOrGenerate(maze, generator, solver, PRIMS, demoSeeds(demoPicker));
                             player.reset();
                             moves = 0;
                             startTime = time(NULL);
                             showSolution = false;
 
-                            buildDemoPath(maze, demoState.path);
+                            buildDemoPath(maze, solver.getLastResult(), demoState.path);
                             demoState.currentStep = 0;
                             demoState.isPlaying = true;
                             demoState.lastMoveTime = al_get_time();
@@ -918,9 +879,7 @@ int main() {
                         showSolution = !showSolution;
                     }
                     else if (event.keyboard.keycode == ALLEGRO_KEY_SPACE) {
-                        generator.generate();
-                        solver.solveBFS();
-                        player.reset();
+                        session.next();
                         moves = 0;
                         startTime = time(NULL);
                     }
@@ -942,7 +901,7 @@ int main() {
                                 gameStats.mazeCols = difficulties[selectedDifficulty].cols;
                                 gameStats.moves = moves;
                                 gameStats.timeSeconds = difftime(time(NULL), startTime);
-                                gameStats.optimalPathLength = countSolutionLength(maze);
+                                gameStats.optimalPathLength = solver.getPathLength();
                                 stats.addGame(gameStats);
                                 stats.saveToFile();
                             }
@@ -964,18 +923,8 @@ int main() {
                         currentDifficulty = (Difficulty)selectedDifficulty;
                         DifficultyConfig config = difficulties[selectedDifficulty];
 
-                        Maze newMaze(config.rows, config.cols);
-                        maze = newMaze;
-
-                        generator = MazeGenerator(&maze);
-                        solver = MazeSolver(&maze);
-                        player = Player(&maze);
-
-                        generator.generate();
-                        solver.solveBFS();
-                        player.reset();
-                        moves = 0;
-                        startTime = time(NULL);
+                        // El laberinto se genera en segundo plano mientras se elige el algoritmo
+                        session.prepare(config.rows, config.cols, algorithmItems[selectedAlgorithm].algorithm);
                         showSolution = false;
                         state = SELECCION_ALGORITMO;
                     }
@@ -987,26 +936,21 @@ int main() {
                     if (event.keyboard.keycode == ALLEGRO_KEY_UP) {
                         playSound(tieSound, 0.3f);
                         selectedAlgorithm = (selectedAlgorithm - 1 + NUM_ALGORITHMS) % NUM_ALGORITHMS;
+                        session.prepare(difficulties[selectedDifficulty].rows,
+                            difficulties[selectedDifficulty].cols, algorithmItems[selectedAlgorithm].algorithm);
                     }
                     else if (event.keyboard.keycode == ALLEGRO_KEY_DOWN) {
                         playSound(tieSound, 0.3f);
                         selectedAlgorithm = (selectedAlgorithm + 1) % NUM_ALGORITHMS;
+                        session.prepare(difficulties[selectedDifficulty].rows,
+                            difficulties[selectedDifficulty].cols, algorithmItems[selectedAlgorithm].algorithm);
                     }
                     else if (event.keyboard.keycode == ALLEGRO_KEY_ENTER) {
                         playSound(xwingSound, 0.5f);
                         currentDifficulty = (Difficulty)selectedDifficulty;
                         DifficultyConfig config = difficulties[selectedDifficulty];
 
-                        Maze newMaze(config.rows, config.cols);
-                        maze = newMaze;
-
-                        generator = MazeGenerator(&maze);
-                        solver = MazeSolver(&maze);
-                        player = Player(&maze);
-
-                        generator.generate(algorithmItems[selectedAlgorithm].algorithm);
-                        solver.solveBFS();
-                        player.reset();
+                        session.start(config.rows, config.cols, algorithmItems[selectedAlgorithm].algorithm);
                         moves = 0;
                         startTime = time(NULL);
                         showSolution = false;
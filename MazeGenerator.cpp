@@ -1,19 +1,61 @@
 ﻿#include "MazeGenerator.h"
+#include "CounterRng.h"
+#include "MazeKernels.h"
 #include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+// Pasos del generador por contador en la generación por teselas
+static const uint64_t STEP_TILE_SEED = 0;
+static const uint64_t STEP_STITCH_ORDER = 1;
+static const uint64_t STEP_STITCH_DOOR = 2;
+
+// Milisegundos transcurridos desde 'since'
+static double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
 
-UnionFind::UnionFind(int size) {
-    parent.resize(size);
-    rank.resize(size, 0);
-    for (int i = 0; i < size; i++) {
-        parent[i] = i;
+const char* getAlgorithmName(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+    case RECURSIVE_BACKTRACKER: return "Recursive Backtracker";
+    case PRIMS: return "Prim's Algorithm";
+    case KRUSKALS: return "Kruskal's Algorithm";
+    case ELLERS: return "Eller's Algorithm";
+    default: return "Unknown";
     }
 }
 
+bool recordTreePaysOff(MazeAlgorithm algorithm) {
+    return algorithm != KRUSKALS;
+}
+
+void GenerationReport::print() const {
+    std::cout << getAlgorithmName(algorithm) << " (seed " << seed << "): "
+        << cellsProcessed << " cells processed, " << wallsRemoved << " walls removed, "
+        << totalMs() << " ms (reset " << resetMs << ", carve " << carveMs
+        << ", cleanup " << cleanupMs << "), " << peakScratchBytes << " bytes scratch." << std::endl;
+}
+
+UnionFind::UnionFind(int size) {
+    reset(size);
+}
+
+void UnionFind::reset(int size) {
+    // Cada elemento empieza como raíz de un conjunto de tamaño 1
+    parent.assign(size, -1);
+}
+
 int UnionFind::find(int x) {
-    if (parent[x] != x) {
-        parent[x] = find(parent[x]);  // Path compression
+    // Iterativo con path halving: sin recursión, no desborda la pila
+    while (parent[x] >= 0) {
+        int p = parent[x];
+        if (parent[p] >= 0) {
+            parent[x] = parent[p];
+        }
+        x = parent[x];
     }
-    return parent[x];
+    return x;
 }
 
 bool UnionFind::unite(int x, int y) {
@@ -24,63 +66,71 @@ bool UnionFind::unite(int x, int y) {
         return false;  
     }
 
-    // Union by rank
-    if (rank[rootX] < rank[rootY]) {
-        parent[rootX] = rootY;
-    }
-    else if (rank[rootX] > rank[rootY]) {
-        parent[rootY] = rootX;
-    }
-    else {
-        parent[rootY] = rootX;
-        rank[rootX]++;
+    // Union by size (el tamaño se guarda negado en la raíz)
+    if (parent[rootX] > parent[rootY]) {
+        std::swap(rootX, rootY);
     }
+    parent[rootX] += parent[rootY];
+    parent[rootY] = rootX;
 
     return true;
 }
-MazeGenerator::MazeGenerator(Maze* m) : maze(m) {
+
+template <typename Rng>
+BasicMazeGenerator<Rng>::BasicMazeGenerator(Maze* m) : maze(m), legacyPrims(false),
+    stacklessBacktracker(false), verbose(false), recordTree(false), currentSeed(0), freshSeed(false) {
     if (maze == nullptr) {
         std::cerr << "Error: MazeGenerator initialized with null maze!" << std::endl;
         return;
     }
 
     std::random_device rd;
-    rng.seed(rd());
+    setSeed(rd());
 }
 
-void MazeGenerator::setSeed(unsigned int seed) {
+template <typename Rng>
+void BasicMazeGenerator<Rng>::setSeed(unsigned int seed) {
     rng.seed(seed);
+    currentSeed = seed;
+    freshSeed = true;
 }
 
-void MazeGenerator::generateWithSeed(unsigned int seed, MazeAlgorithm algorithm) {
+template <typename Rng>
+const GenerationReport& BasicMazeGenerator<Rng>::generateWithSeed(unsigned int seed, MazeAlgorithm algorithm) {
     setSeed(seed);
-    generate(algorithm);
+    return generate(algorithm);
 }
 
-void MazeGenerator::generateRecursiveBacktracker() {
-    maze->reset();
+template <typename Rng>
+void BasicMazeGenerator<Rng>::generateRecursiveBacktracker() {
+    int cols = maze->getCols();
 
-    std::stack<Cell*> stack;
-    Cell* current = &maze->getCell(0, 0);
-    current->visited = true;
-    stack.push(current);
+    std::stack<int> stack;
+    maze->setVisited(0, 0, true);
+    stack.push(maze->cellIndex(0, 0));
 
-    int totalCells = maze->getRows() * maze->getCols();
     int visitedCells = 1;
+    size_t maxDepth = 1;
 
     while (!stack.empty()) {
-        current = stack.top();
+        int row = stack.top() / cols;
+        int col = stack.top() % cols;
 
-        std::vector<Cell*> neighbors = maze->getUnvisitedNeighbors(current);
+        NeighborList neighbors(maze->unvisitedNeighborMask(row, col));
 
-        if (!neighbors.empty()) {
-            std::uniform_int_distribution<int> dist(0, neighbors.size() - 1);
-            Cell* next = neighbors[dist(rng)];
+        if (neighbors.count > 0) {
+            int dir = neighbors.dirs[rng.below(neighbors.count)];
+            int nextRow = row + DIR_DR[dir];
+            int nextCol = col + DIR_DC[dir];
 
-            maze->removeWall(*current, *next);
+            maze->openWall(row, col, dir);
+            if (recordTree) {
+                tree.setParent(maze->cellIndex(nextRow, nextCol), oppositeDirection(dir));
+            }
 
-            next->visited = true;
-            stack.push(next);
+            maze->setVisited(nextRow, nextCol, true);
+            stack.push(maze->cellIndex(nextRow, nextCol));
+            maxDepth = std::max(maxDepth, stack.size());
 
             visitedCells++;
         }
@@ -89,117 +139,150 @@ void MazeGenerator::generateRecursiveBacktracker() {
         }
     }
 
-    maze->clearVisited();
-
-    std::cout << "Recursive Backtracker: " << visitedCells << "/" << totalCells
-        << " cells processed." << std::endl;
+    lastReport.cellsProcessed = visitedCells;
+    lastReport.wallsRemoved = visitedCells - 1;
+    lastReport.peakScratchBytes = maxDepth * sizeof(int);
 }
 
-void MazeGenerator::generatePrims() {
-    maze->reset();
+template <typename Rng>
+void BasicMazeGenerator<Rng>::generateStacklessBacktracker() {
+    int totalCells = maze->getRows() * maze->getCols();
 
-    std::vector<Cell*> frontiers;
+    // Dirección hacia la celda de la que se llegó: 2 bits por celda.
+    // Retroceder es seguir esa dirección, así que no hace falta una pila.
+    cameFrom.assign((totalCells + 3) / 4, 0);
 
-    Cell* start = &maze->getCell(0, 0);
-    start->visited = true;
+    int visitedCells = carveStacklessBacktracker(*maze, rng, cameFrom.data());
 
-    auto neighbors = maze->getUnvisitedNeighbors(start);
-    for (auto n : neighbors) {
-        frontiers.push_back(n);
+    // Las direcciones de llegada ya son el árbol con raíz en (0, 0)
+    if (recordTree) {
+        tree.setParentDirs(cameFrom.data(), 0);
     }
 
+    lastReport.cellsProcessed = visitedCells;
+    lastReport.wallsRemoved = visitedCells - 1;
+    lastReport.peakScratchBytes = cameFrom.capacity();
+}
+
+template <typename Rng>
+void BasicMazeGenerator<Rng>::generatePrims() {
+    int cols = maze->getCols();
     int totalCells = maze->getRows() * maze->getCols();
+
+    // Frontera como índices de celda + un bit por celda para saber en O(1)
+    // si ya está en la frontera (sustituye a std::find)
+    std::vector<int> frontiers;
+    inFrontier.assign((totalCells + 63) / 64, 0);
+
+    auto addFrontier = [&](int r, int c, int) {
+        int id = r * cols + c;
+        uint64_t bit = uint64_t(1) << (id & 63);
+        if ((inFrontier[id >> 6] & bit) == 0) {
+            inFrontier[id >> 6] |= bit;
+            frontiers.push_back(id);
+        }
+    };
+
+    maze->setVisited(0, 0, true);
+    maze->forEachNeighbor(0, 0, maze->unvisitedNeighborMask(0, 0), addFrontier);
+
     int visitedCells = 1;
 
     while (!frontiers.empty()) {
-        std::uniform_int_distribution<int> dist(0, frontiers.size() - 1);
-        int idx = dist(rng);
-        Cell* current = frontiers[idx];
-        frontiers.erase(frontiers.begin() + idx);
-
-        std::vector<Cell*> visitedNeighbors;
-        auto allNeighbors = maze->getNeighbors(current);
-        for (auto n : allNeighbors) {
-            if (n->visited) {
-                visitedNeighbors.push_back(n);
-            }
-        }
+        int idx = rng.below(static_cast<int>(frontiers.size()));
+        int current = frontiers[idx];
 
-        if (!visitedNeighbors.empty()) {
-            std::uniform_int_distribution<int> dist2(0, visitedNeighbors.size() - 1);
-            Cell* neighbor = visitedNeighbors[dist2(rng)];
-            maze->removeWall(*current, *neighbor);
+        if (legacyPrims) {
+            // Orden original (O(frontera)): reproduce los laberintos de semillas antiguas
+            frontiers.erase(frontiers.begin() + idx);
+        }
+        else {
+            // Intercambiar con el último y quitarlo: O(1)
+            frontiers[idx] = frontiers.back();
+            frontiers.pop_back();
+        }
+        inFrontier[current >> 6] &= ~(uint64_t(1) << (current & 63));
+
+        int row = current / cols;
+        int col = current % cols;
+        unsigned unvisited = maze->unvisitedNeighborMask(row, col);
+        NeighborList visitedNeighbors(maze->neighborMask(row, col) & ~unvisited);
+
+        if (visitedNeighbors.count > 0) {
+            int dir = visitedNeighbors.dirs[rng.below(visitedNeighbors.count)];
+            maze->openWall(row, col, dir);
+            if (recordTree) {
+                tree.setParent(current, dir);
+            }
 
-            current->visited = true;
+            maze->setVisited(row, col, true);
             visitedCells++;
 
-            auto newNeighbors = maze->getUnvisitedNeighbors(current);
-            for (auto n : newNeighbors) {
-                if (std::find(frontiers.begin(), frontiers.end(), n) == frontiers.end()) {
-                    frontiers.push_back(n);
-                }
-            }
+            maze->forEachNeighbor(row, col, unvisited, addFrontier);
         }
     }
 
-    maze->clearVisited();
-
-    std::cout << "Prim's Algorithm: " << visitedCells << "/" << totalCells
-        << " cells processed." << std::endl;
+    lastReport.cellsProcessed = visitedCells;
+    lastReport.wallsRemoved = visitedCells - 1;
+    lastReport.peakScratchBytes = frontiers.capacity() * sizeof(int) + inFrontier.capacity() * sizeof(uint64_t);
 }
 
-void MazeGenerator::generateKruskals() {
-    maze->reset();
-
+template <typename Rng>
+void BasicMazeGenerator<Rng>::generateKruskals() {
     int rows = maze->getRows();
     int cols = maze->getCols();
     int totalCells = rows * cols;
 
+    // Cada pared interior es un uint32: celda * 2 + orientación
+    // (0 = pared derecha, 1 = pared inferior)
+    std::vector<uint32_t> walls;
+    walls.reserve(static_cast<size_t>(rows) * (cols - 1) + static_cast<size_t>(rows - 1) * cols);
 
-    struct Wall {
-        Cell* cell1;
-        Cell* cell2;
-    };
-
-    std::vector<Wall> walls;
-
- 
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
-            Cell* current = &maze->getCell(i, j);
+            uint32_t id = static_cast<uint32_t>(i * cols + j) * 2;
 
-          
             if (j < cols - 1) {
-                walls.push_back({ current, &maze->getCell(i, j + 1) });
+                walls.push_back(id);
             }
-           
             if (i < rows - 1) {
-                walls.push_back({ current, &maze->getCell(i + 1, j) });
+                walls.push_back(id + 1);
             }
         }
     }
 
     
-    std::shuffle(walls.begin(), walls.end(), rng);
+    rng.shuffle(walls.begin(), walls.end());
 
     
     UnionFind uf(totalCells);
 
-    
-    auto getCellId = [cols](Cell* cell) {
-        return cell->row * cols + cell->col;
-        };
-
     int wallsRemoved = 0;
 
     
-    for (const auto& wall : walls) {
-        int id1 = getCellId(wall.cell1);
-        int id2 = getCellId(wall.cell2);
+    for (uint32_t wall : walls) {
+        int cell = static_cast<int>(wall >> 1);
+        bool bottom = (wall & 1) != 0;
+        int other = bottom ? cell + cols : cell + 1;
 
         
-        if (uf.unite(id1, id2)) {
-            maze->removeWall(*wall.cell1, *wall.cell2);
+        // Registrando el árbol se buscan las raíces una sola vez (unite() sobre
+        // raíces no recorre nada) y se re-enraíza el árbol más pequeño, así
+        // el coste total de las inversiones es O(n log n)
+        int x = cell;
+        int y = other;
+        if (recordTree) {
+            x = uf.find(cell);
+            y = uf.find(other);
+            if (x != y) {
+                if (uf.setSize(x) <= uf.setSize(y)) tree.link(cell, bottom ? DIR_DOWN : DIR_RIGHT);
+                else tree.link(other, bottom ? DIR_UP : DIR_LEFT);
+            }
+        }
+
+        if (uf.unite(x, y)) {
+            if (bottom) maze->openBottomWall(cell / cols, cell % cols);
+            else maze->openRightWall(cell / cols, cell % cols);
             wallsRemoved++;
 
             
@@ -209,109 +292,218 @@ void MazeGenerator::generateKruskals() {
         }
     }
 
-    std::cout << "Kruskal's Algorithm: " << wallsRemoved << " walls removed, "
-        << totalCells << " cells connected." << std::endl;
+    lastReport.cellsProcessed = totalCells;
+    lastReport.wallsRemoved = wallsRemoved;
+    lastReport.peakScratchBytes = walls.capacity() * sizeof(uint32_t) + uf.getMemoryBytes();
 }
 
 // ========== Eller's Algorithm ==========
-void MazeGenerator::generateEllers() {
-    maze->reset();
+void EllerRowState::init(int width) {
+    cols = width;
+    setOf.resize(cols);
+    head.resize(cols);
+    next.resize(cols);
+    count.resize(cols);
+    used.resize(cols);
+
+    // Primera fila: cada celda en su propio conjunto
+    for (int c = 0; c < cols; c++) {
+        setOf[c] = c;
+    }
+}
 
-    int rows = maze->getRows();
-    int cols = maze->getCols();
+void EllerRowState::beginRow() {
+    sets.reset(cols);
+}
 
-    
-    std::vector<int> rowSets(cols);
-    int nextSetId = 0;
+size_t EllerRowState::getMemoryBytes() const {
+    return (setOf.capacity() + head.capacity() + next.capacity() + count.capacity() +
+        treeSize.capacity()) * sizeof(int) +
+        used.capacity() + sets.getMemoryBytes() +
+        (rightWalls.capacity() + bottomWalls.capacity()) * sizeof(uint64_t);
+}
 
-    
-    for (int i = 0; i < cols; i++) {
-        rowSets[i] = nextSetId++;
+template <typename Rng>
+void BasicMazeGenerator<Rng>::generateEllers() {
+    MazeGridSink sink(maze);
+    runEllers(maze->getRows(), maze->getCols(), sink, recordTree ? &tree : nullptr);
+}
+
+template <typename Rng>
+long long BasicMazeGenerator<Rng>::generateEllersStream(long long rows, int cols, MazeRowSink& sink) {
+    lastReport.clear();
+    lastReport.algorithm = ELLERS;
+
+    // Misma política de semillas que generate(): cada flujo es reproducible
+    if (!freshSeed) {
+        setSeed(rng.next32());
     }
+    freshSeed = false;
+    lastReport.seed = currentSeed;
 
-    for (int row = 0; row < rows; row++) {
-        
+    std::chrono::steady_clock::time_point phaseStart = std::chrono::steady_clock::now();
+    long long emitted = runEllers(rows, cols, sink, nullptr);
+    lastReport.carveMs = elapsedMs(phaseStart);
+
+    if (verbose) {
+        lastReport.print();
+    }
+
+    return emitted;
+}
+
+template <typename Rng>
+long long BasicMazeGenerator<Rng>::runEllers(long long rows, int cols, MazeRowSink& sink, SpanningTree* treeOut) {
+    if (rows <= 0 || cols <= 0) {
+        std::cerr << "Error: Cannot stream maze - dimensions must be positive" << std::endl;
+        return 0;
+    }
+
+    // Cada fila usa etiquetas de conjunto en [0, cols) y un union-find sobre
+    // ellas; los buffers se reservan una vez y se reutilizan en cada fila.
+    EllerRowState& state = eller;
+    state.init(cols);
+    if (treeOut != nullptr) {
+        state.treeSize.assign(cols, 1);
+    }
+
+    // Paredes de la fila en curso, en el formato de los planos de Maze
+    int wordsPerRow = (cols + 63) / 64;
+    state.rightWalls.resize(wordsPerRow);
+    state.bottomWalls.resize(wordsPerRow);
+    uint64_t* right = state.rightWalls.data();
+    uint64_t* bottom = state.bottomWalls.data();
+
+    long long wallsRemoved = 0;
+
+    for (long long row = 0; row < rows; row++) {
+        bool lastRow = (row == rows - 1);
+        state.beginRow();
+        std::fill(right, right + wordsPerRow, ~uint64_t(0));
+        std::fill(bottom, bottom + wordsPerRow, ~uint64_t(0));
+
+        // Uniones horizontales
         for (int col = 0; col < cols - 1; col++) {
-            
-            std::uniform_int_distribution<int> dist(0, 1);
-
-            if (rowSets[col] != rowSets[col + 1] &&
-                (row == rows - 1 || dist(rng) == 0)) {
-                
-                Cell* current = &maze->getCell(row, col);
-                Cell* right = &maze->getCell(row, col + 1);
-                maze->removeWall(*current, *right);
-
-                
-                int oldSet = rowSets[col + 1];
-                int newSet = rowSets[col];
-                for (int c = 0; c < cols; c++) {
-                    if (rowSets[c] == oldSet) {
-                        rowSets[c] = newSet;
-                    }
+            int setA = state.sets.find(state.setOf[col]);
+            int setB = state.sets.find(state.setOf[col + 1]);
+            if (setA != setB && (lastRow || rng.below(2) == 0)) {
+                right[col >> 6] &= ~(uint64_t(1) << (col & 63));
+                state.sets.unite(setA, setB);
+                wallsRemoved++;
+
+                // Re-enraizar el árbol más pequeño y colgarlo del otro
+                if (treeOut != nullptr) {
+                    int cell = static_cast<int>(row) * cols + col;
+                    int sizeA = state.treeSize[setA];
+                    int sizeB = state.treeSize[setB];
+                    if (sizeA <= sizeB) treeOut->link(cell, DIR_RIGHT);
+                    else treeOut->link(cell + 1, DIR_LEFT);
+                    state.treeSize[state.sets.find(setA)] = sizeA + sizeB;
                 }
             }
         }
 
        
-        if (row == rows - 1) {
+        if (lastRow) {
+            sink.consumeRow(row, right, bottom, cols);
             break;
         }
 
-        
-        std::map<int, std::vector<int>> setMembers;
+        // Listas de miembros por conjunto (enlazadas, en orden de columna)
         for (int col = 0; col < cols; col++) {
-            setMembers[rowSets[col]].push_back(col);
+            state.setOf[col] = state.sets.find(state.setOf[col]);
+            state.head[col] = -1;
+            state.count[col] = 0;
+            state.used[col] = 0;
+        }
+        for (int col = cols - 1; col >= 0; col--) {
+            int set = state.setOf[col];
+            state.next[col] = state.head[set];
+            state.head[set] = col;
+            state.count[set]++;
         }
 
-        std::vector<int> nextRowSets(cols, -1);
+        // Uniones verticales: un miembro elegido al azar baja siempre y los
+        // demás con probabilidad 1/2 (misma distribución que barajar los
+        // miembros y forzar el primero); las columnas ya descartadas por un
+        // conjunto anterior tienen etiqueta -1 y se saltan
+        for (int col = 0; col < cols; col++) {
+            int set = state.setOf[col];
+            if (set < 0 || state.head[set] != col) continue;
 
-        for (auto& pair : setMembers) {
-            int setId = pair.first;
-            std::vector<int>& members = pair.second;
+            int forced = rng.below(state.count[set]);
+            int k = 0;
 
-            
-            std::shuffle(members.begin(), members.end(), rng);
+            for (int member = col; member != -1; member = state.next[member], k++) {
+                if (k == forced || rng.below(2) == 0) {
+                    bottom[member >> 6] &= ~(uint64_t(1) << (member & 63));
+                    state.used[set] = 1;
+                    wallsRemoved++;
 
-            
-            std::uniform_int_distribution<int> dist(0, 1);
-            bool hasConnection = false;
-
-            for (int col : members) {
-                if (!hasConnection || dist(rng) == 0) {
-                    
-                    Cell* current = &maze->getCell(row, col);
-                    Cell* below = &maze->getCell(row + 1, col);
-                    maze->removeWall(*current, *below);
-
-                    
-                    nextRowSets[col] = setId;
-                    hasConnection = true;
+                    if (treeOut != nullptr) {
+                        treeOut->setParent(static_cast<int>(row + 1) * cols + member, DIR_UP);
+                        state.treeSize[set]++;
+                    }
                 }
                 else {
-                    
-                    nextRowSets[col] = nextSetId++;
+                    state.setOf[member] = -1;
                 }
             }
         }
 
-        rowSets = nextRowSets;
+        // Las celdas que no bajan reciben etiquetas libres para la fila siguiente
+        int freeLabel = 0;
+        for (int col = 0; col < cols; col++) {
+            if (state.setOf[col] != -1) continue;
+
+            while (state.used[freeLabel]) freeLabel++;
+            state.used[freeLabel] = 1;
+            state.setOf[col] = freeLabel;
+            if (treeOut != nullptr) {
+                state.treeSize[freeLabel] = 1;
+            }
+        }
+
+        sink.consumeRow(row, right, bottom, cols);
     }
 
-    std::cout << "Eller's Algorithm: Maze generated row by row, "
-        << rows * cols << " cells processed." << std::endl;
+    lastReport.algorithm = ELLERS;
+    lastReport.cellsProcessed = rows * cols;
+    lastReport.wallsRemoved = wallsRemoved;
+    lastReport.peakScratchBytes = state.getMemoryBytes();
+
+    return rows;
 }
 // ========== Eller's ==========
 
-void MazeGenerator::generate(MazeAlgorithm algorithm) {
+template <typename Rng>
+const GenerationReport& BasicMazeGenerator<Rng>::generate(MazeAlgorithm algorithm) {
+    lastReport.clear();
+    lastReport.algorithm = algorithm;
+
     if (maze == nullptr) {
         std::cerr << "Error: Cannot generate maze - maze is null!" << std::endl;
-        return;
+        return lastReport;
+    }
+
+    // Cada laberinto sale de una semilla conocida
+    if (!freshSeed) {
+        setSeed(rng.next32());
     }
+    freshSeed = false;
+    lastReport.seed = currentSeed;
 
+    std::chrono::steady_clock::time_point phaseStart = std::chrono::steady_clock::now();
+    maze->reset();
+    if (recordTree) tree.reset(maze->getRows(), maze->getCols());
+    else tree.clear();
+    lastReport.resetMs = elapsedMs(phaseStart);
+
+    phaseStart = std::chrono::steady_clock::now();
     switch (algorithm) {
     case RECURSIVE_BACKTRACKER:
-        generateRecursiveBacktracker();
+        if (stacklessBacktracker) generateStacklessBacktracker();
+        else generateRecursiveBacktracker();
         break;
     case PRIMS:
         generatePrims();
@@ -323,10 +515,171 @@ void MazeGenerator::generate(MazeAlgorithm algorithm) {
         generateEllers();
         break;
     default:
-        generateRecursiveBacktracker();
+        if (stacklessBacktracker) generateStacklessBacktracker();
+        else generateRecursiveBacktracker();
         break;
     }
+    lastReport.carveMs = elapsedMs(phaseStart);
+
+    phaseStart = std::chrono::steady_clock::now();
+    maze->clearVisited();
+    if (recordTree) {
+        // Los árboles salen con raíz en (0, 0) o en cualquier celda (Kruskal's,
+        // Eller's): se invierte el camino para que la raíz sea el inicio
+        tree.reroot(maze->getStartIndex());
+    }
+    lastReport.cleanupMs = elapsedMs(phaseStart);
+
+    if (verbose) {
+        lastReport.print();
+    }
+
+    return lastReport;
+}
+
+template <typename Rng>
+const GenerationReport& BasicMazeGenerator<Rng>::generateParallel(MazeAlgorithm algorithm, int threads,
+    int tileRows, int tileCols) {
+    return generateParallelWithSeed(rng.next32(), algorithm, threads, tileRows, tileCols);
+}
+
+template <typename Rng>
+const GenerationReport& BasicMazeGenerator<Rng>::generateParallelWithSeed(unsigned int seed,
+    MazeAlgorithm algorithm, int threads, int tileRows, int tileCols) {
+    lastReport.clear();
+    lastReport.algorithm = algorithm;
+    lastReport.seed = seed;
+
+    if (maze == nullptr) {
+        std::cerr << "Error: Cannot generate maze - maze is null!" << std::endl;
+        return lastReport;
+    }
+
+    int rows = maze->getRows();
+    int cols = maze->getCols();
+
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (threads <= 0) threads = 1;
+    }
+
+    // Los bordes de columna de las teselas caen en límites de palabra de 64 bits,
+    // así cada hilo escribe palabras propias al copiar su tesela al laberinto
+    if (tileRows <= 0) tileRows = 256;
+    if (tileCols <= 0) tileCols = 256;
+    tileCols = ((tileCols + 63) / 64) * 64;
+    if (tileRows > rows) tileRows = rows;
+    if (tileCols > cols) tileCols = cols;
+
+    int tilesDown = (rows + tileRows - 1) / tileRows;
+    int tilesAcross = (cols + tileCols - 1) / tileCols;
+    int totalTiles = tilesDown * tilesAcross;
+
+    std::chrono::steady_clock::time_point phaseStart = std::chrono::steady_clock::now();
+    maze->reset();
+    tree.clear();
+    lastReport.resetMs = elapsedMs(phaseStart);
+
+    phaseStart = std::chrono::steady_clock::now();
+
+    // 1. Generar cada tesela de forma independiente. Cada hilo anota el
+    // informe de sus teselas en su propia posición y se suman al final.
+    std::vector<GenerationReport> tileReports(totalTiles);
+    std::vector<size_t> tileMemory(totalTiles);
+    std::atomic<int> nextTile(0);
+    auto worker = [&]() {
+        int t;
+        while ((t = nextTile.fetch_add(1)) < totalTiles) {
+            int r0 = (t / tilesAcross) * tileRows;
+            int c0 = (t % tilesAcross) * tileCols;
+            int h = std::min(tileRows, rows - r0);
+            int w = std::min(tileCols, cols - c0);
+
+            Maze tile(h, w);
+            BasicMazeGenerator<Rng> tileGenerator(&tile);
+            tileGenerator.setVerbose(false);
+            tileGenerator.setLegacyPrims(legacyPrims);
+            tileGenerator.setStacklessBacktracker(stacklessBacktracker);
+            // La semilla de cada tesela sale de (semilla, tesela): el resultado no
+            // depende del número de hilos ni del orden en que terminen
+            tileReports[t] = tileGenerator.generateWithSeed(
+                static_cast<unsigned int>(CounterRng::hash(seed, t, STEP_TILE_SEED)), algorithm);
+            tileMemory[t] = tile.getMemoryBytes();
+
+            maze->copyWallsFrom(tile, r0, c0);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads && i < totalTiles; i++) {
+        pool.push_back(std::thread(worker));
+    }
+    worker();
+    for (auto& th : pool) {
+        th.join();
+    }
+
+    // Como mucho hay una tesela en curso por hilo: se estima el pico como
+    // la tesela más costosa multiplicada por los hilos activos
+    size_t tilePeak = 0;
+    for (int t = 0; t < totalTiles; t++) {
+        lastReport.cellsProcessed += tileReports[t].cellsProcessed;
+        lastReport.wallsRemoved += tileReports[t].wallsRemoved;
+        tilePeak = std::max(tilePeak, tileReports[t].peakScratchBytes + tileMemory[t]);
+    }
+    lastReport.peakScratchBytes = tilePeak * std::min(threads, totalTiles);
+
+    // 2. Unir las teselas con un árbol de expansión aleatorio sobre el grafo
+    // de adyacencia de teselas, abriendo una sola pared por frontera elegida.
+    // El orden es un peso aleatorio por frontera (Kruskal), calculado con hash
+    std::vector<std::pair<uint64_t, uint32_t>> tileEdges;
+    for (int t = 0; t < totalTiles; t++) {
+        for (uint32_t orientation = 0; orientation < 2; orientation++) {
+            if (orientation == 0 && t % tilesAcross == tilesAcross - 1) continue;
+            if (orientation == 1 && t / tilesAcross == tilesDown - 1) continue;
+            uint32_t edge = static_cast<uint32_t>(t) * 2 + orientation;
+            tileEdges.push_back(std::make_pair(CounterRng::hash(seed, edge, STEP_STITCH_ORDER), edge));
+        }
+    }
+    std::sort(tileEdges.begin(), tileEdges.end());
+
+    UnionFind tileSets(totalTiles);
+    for (const auto& weighted : tileEdges) {
+        uint32_t edge = weighted.second;
+        int t = static_cast<int>(edge >> 1);
+        bool below = (edge & 1) != 0;
+        int other = below ? t + tilesAcross : t + 1;
+        if (!tileSets.unite(t, other)) continue;
+
+        int r0 = (t / tilesAcross) * tileRows;
+        int c0 = (t % tilesAcross) * tileCols;
+        int h = std::min(tileRows, rows - r0);
+        int w = std::min(tileCols, cols - c0);
+
+        uint64_t door = CounterRng::hash(seed, edge, STEP_STITCH_DOOR);
+        if (below) {
+            maze->openBottomWall(r0 + h - 1, c0 + CounterRng::bounded(door, w));
+        }
+        else {
+            maze->openRightWall(r0 + CounterRng::bounded(door, h), c0 + w - 1);
+        }
+        lastReport.wallsRemoved++;
+    }
+
+    lastReport.peakScratchBytes = std::max(lastReport.peakScratchBytes,
+        tileEdges.capacity() * sizeof(tileEdges[0]) + tileSets.getMemoryBytes());
+    lastReport.carveMs = elapsedMs(phaseStart);
+
+    if (verbose) {
+        std::cout << "Parallel generation: " << totalTiles << " tiles of " << tileRows << "x"
+            << tileCols << " on " << threads << " threads." << std::endl;
+        lastReport.print();
+    }
+
+    return lastReport;
+}
 
-    maze->getCell(0, 0).isStart = true;
-    maze->getCell(maze->getRows() - 1, maze->getCols() - 1).isEnd = true;
-}
\ No newline at end of file
+// Instancias de las políticas incluidas
+template class BasicMazeGenerator<Mt19937Rng>;
+template class BasicMazeGenerator<Xoshiro256Rng>;
+template class BasicMazeGenerator<WyRandRng>;
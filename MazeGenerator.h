@@ -2,12 +2,16 @@
 #define MAZE_GENERATOR_H
 
 #include "Maze.h"
+#include "MazeRowSink.h"
+#include "MazeRng.h"
+#include "SpanningTree.h"
 #include <stack>
 #include <random>
 #include <vector>
 #include <algorithm>
 #include <set>
 #include <map>
+#include <cstdint>
 
 enum MazeAlgorithm {
     RECURSIVE_BACKTRACKER,
@@ -16,33 +20,179 @@ enum MazeAlgorithm {
     ELLERS
 };
 
+// Resultado de una generación: qué se generó, cuánto trabajo hizo y cuánto
+// tardó cada fase. Los tiempos son de reloj de pared, en milisegundos.
+struct GenerationReport {
+    MazeAlgorithm algorithm;
+    unsigned int seed;          // Semilla que reproduce este laberinto
+    long long cellsProcessed;
+    long long wallsRemoved;
+    double resetMs;             // Restaurar paredes y estados
+    double carveMs;             // Algoritmo de generación
+    double cleanupMs;           // Limpiar las marcas de trabajo
+    size_t peakScratchBytes;    // Memoria de trabajo máxima (sin contar el laberinto)
+
+    GenerationReport() {
+        clear();
+    }
+
+    void clear() {
+        algorithm = RECURSIVE_BACKTRACKER;
+        seed = 0;
+        cellsProcessed = 0;
+        wallsRemoved = 0;
+        resetMs = 0.0;
+        carveMs = 0.0;
+        cleanupMs = 0.0;
+        peakScratchBytes = 0;
+    }
+
+    double totalMs() const { return resetMs + carveMs + cleanupMs; }
+
+    // Resumen de una línea por consola
+    void print() const;
+};
+
+const char* getAlgorithmName(MazeAlgorithm algorithm);
+
+// Si conviene registrar el árbol de expansión (setRecordTree) para resolver
+// con solveFromTree() en lugar de con un BFS. En Kruskal's no: une árboles en
+// orden aleatorio y en laberintos grandes registrar cuesta más que el BFS.
+bool recordTreePaysOff(MazeAlgorithm algorithm);
+
 class UnionFind {
 private:
-    std::vector<int> parent;
-    std::vector<int> rank;
+    // parent[x] >= 0: padre de x; parent[x] < 0: x es raíz y -parent[x] es su tamaño
+    std::vector<int32_t> parent;
 
 public:
-    UnionFind(int size);
+    explicit UnionFind(int size = 0);
+    void reset(int size);
     int find(int x);
     bool unite(int x, int y);
+    int setSize(int x) { return -parent[find(x)]; }
+
+    size_t getMemoryBytes() const { return parent.capacity() * sizeof(int32_t); }
 };
 
-class MazeGenerator {
+// Estado de una fila del algoritmo de Eller: etiquetas de conjunto por
+// columna y un union-find sobre ellas. Todo cabe en O(cols) y se reutiliza.
+struct EllerRowState {
+    int cols;
+    std::vector<int> setOf;    // Etiqueta del conjunto de cada columna
+    UnionFind sets;            // Union-find sobre etiquetas
+    std::vector<int> head;     // Primer miembro de cada conjunto
+    std::vector<int> next;     // Siguiente miembro del mismo conjunto
+    std::vector<int> count;    // Número de miembros de cada conjunto
+    std::vector<char> used;    // Etiqueta ocupada en la fila siguiente
+    std::vector<uint64_t> rightWalls;   // Paredes de la fila en curso
+    std::vector<uint64_t> bottomWalls;
+    std::vector<int> treeSize;  // Celdas de cada árbol (solo al registrar el árbol)
+
+    EllerRowState() : cols(0) {
+    }
+
+    void init(int width);
+    void beginRow();
+
+    size_t getMemoryBytes() const;
+};
+
+// Núcleo del generador, parametrizado por la política de números aleatorios
+// (ver MazeRng.h). Las instancias de las políticas incluidas se compilan en
+// MazeGenerator.cpp.
+template <typename Rng>
+class BasicMazeGenerator {
 private:
     Maze* maze;
-    std::mt19937 rng;
+    Rng rng;
+
+    // Prim's: true = quitar de la frontera conservando el orden (secuencia
+    // exacta de versiones anteriores, O(n^2)); false = intercambio O(1)
+    bool legacyPrims;
+
+    // Backtracker sin pila: retrocede siguiendo direcciones guardadas en la celda
+    bool stacklessBacktracker;
+
+    // Mostrar el informe por consola al terminar cada generación (desactivado por defecto)
+    bool verbose;
+
+    // Registrar el árbol de expansión (padre de cada celda, con raíz en el inicio)
+    bool recordTree;
+    SpanningTree tree;
+
+    // Semilla actual del motor y si aún no se ha usado: generate() vuelve a
+    // sembrar con una semilla nueva cuando ya se usó, así cada informe
+    // lleva la semilla exacta de su laberinto
+    unsigned int currentSeed;
+    bool freshSeed;
+
+    GenerationReport lastReport;
+
+    // Memoria de trabajo: bit por celda "está en la frontera" (Prim's),
+    // dirección de llegada de 2 bits por celda (backtracker sin pila)
+    std::vector<uint64_t> inFrontier;
+    std::vector<uint8_t> cameFrom;
+    EllerRowState eller;
 
     void generateRecursiveBacktracker();
+    void generateStacklessBacktracker();
     void generatePrims();
     void generateKruskals();
     void generateEllers();
     void setSeed(unsigned int seed);
 
+    // Eller's sobre un sumidero; con 'treeOut' registra también el árbol
+    long long runEllers(long long rows, int cols, MazeRowSink& sink, SpanningTree* treeOut);
+
 public:
-    explicit MazeGenerator(Maze* m);
+    explicit BasicMazeGenerator(Maze* m);
+
+    const GenerationReport& generate(MazeAlgorithm algorithm = RECURSIVE_BACKTRACKER);
+    const GenerationReport& generateWithSeed(unsigned int seed, MazeAlgorithm algorithm = RECURSIVE_BACKTRACKER);
 
-    void generate(MazeAlgorithm algorithm = RECURSIVE_BACKTRACKER);
-    void generateWithSeed(unsigned int seed, MazeAlgorithm algorithm = RECURSIVE_BACKTRACKER);
+    // Informe de la última generación
+    const GenerationReport& getLastReport() const { return lastReport; }
+
+    // Eller's en streaming: entrega cada fila terminada a 'sink' sin crear
+    // el laberinto completo (memoria O(cols)). Devuelve las filas emitidas;
+    // la semilla, celdas, paredes abiertas, tiempo y memoria quedan en
+    // getLastReport(). Usa las semillas igual que generate().
+    long long generateEllersStream(long long rows, int cols, MazeRowSink& sink);
+
+    void setLegacyPrims(bool enabled) { legacyPrims = enabled; }
+    void setStacklessBacktracker(bool enabled) { stacklessBacktracker = enabled; }
+    bool getLegacyPrims() const { return legacyPrims; }
+    bool getStacklessBacktracker() const { return stacklessBacktracker; }
+    void setVerbose(bool enabled) { verbose = enabled; }
+
+    // Registrar durante la talla el árbol de expansión con raíz en el inicio;
+    // MazeSolver::solveFromTree() lee entonces el camino sin BFS. La
+    // generación paralela no lo registra (el árbol queda vacío).
+    void setRecordTree(bool enabled) { recordTree = enabled; }
+    const SpanningTree& getSpanningTree() const { return tree; }
+
+    // Generación paralela por teselas: cada tesela se genera con 'algorithm'
+    // en un hilo y luego se unen con un árbol de expansión aleatorio entre
+    // teselas, abriendo una pared por frontera, así el laberinto sigue siendo
+    // perfecto. threads <= 0 usa todos los núcleos; el ancho de tesela se
+    // redondea a múltiplos de 64 columnas.
+    const GenerationReport& generateParallel(MazeAlgorithm algorithm, int threads = 0,
+        int tileRows = 0, int tileCols = 0);
+
+    // Igual que generateParallel, pero todo lo aleatorio sale de un hash de
+    // (semilla, índice, paso): la misma semilla da el mismo laberinto con
+    // cualquier número de hilos
+    const GenerationReport& generateParallelWithSeed(unsigned int seed, MazeAlgorithm algorithm, int threads = 0,
+        int tileRows = 0, int tileCols = 0);
 };
 
+// std::mt19937: misma secuencia que antes (Eller's y Prim's no heredado
+// dan otros laberintos con la misma semilla; ver MazeRng.h)
+typedef BasicMazeGenerator<Mt19937Rng> MazeGenerator;
+
+// Políticas rápidas (secuencias distintas para la misma semilla)
+typedef BasicMazeGenerator<Xoshiro256Rng> FastMazeGenerator;
+typedef BasicMazeGenerator<WyRandRng> WyRandMazeGenerator;
+
 #endif
\ No newline at end of file
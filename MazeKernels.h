@@ -0,0 +1,56 @@
+﻿#ifndef MAZE_KERNELS_H
+#define MAZE_KERNELS_H
+
+#include "Maze.h"
+#include <cstdint>
+
+// Núcleos de generación escritos sobre el tipo de laberinto y la política de
+// números aleatorios, para que el compilador los especialice en cada uso.
+// MazeT necesita: getCols(), unvisitedNeighborMask(), openWall() y setVisited().
+
+// Backtracker sin pila: retrocede siguiendo la dirección de llegada guardada
+// en 'cameFrom' (2 bits por celda, (celdas + 3) / 4 bytes ya a cero).
+// Parte de (0, 0) con todas las paredes y sin visitadas; devuelve las celdas visitadas.
+template <typename MazeT, typename Rng>
+int carveStacklessBacktracker(MazeT& maze, Rng& rng, uint8_t* cameFrom) {
+    int cols = maze.getCols();
+
+    int row = 0;
+    int col = 0;
+    maze.setVisited(row, col, true);
+    int visitedCells = 1;
+
+    while (true) {
+        NeighborList neighbors(maze.unvisitedNeighborMask(row, col));
+
+        if (neighbors.count > 0) {
+            // Entero acotado sin divisiones ni ramas: (r * count) >> 32
+            uint32_t r = rng.next32();
+            int dir = neighbors.dirs[(static_cast<uint64_t>(r) * neighbors.count) >> 32];
+
+            maze.openWall(row, col, dir);
+            row += DIR_DR[dir];
+            col += DIR_DC[dir];
+            maze.setVisited(row, col, true);
+
+            int id = row * cols + col;
+            int shift = (id & 3) * 2;
+            cameFrom[id >> 2] = static_cast<uint8_t>(
+                (cameFrom[id >> 2] & ~(3 << shift)) | (oppositeDirection(dir) << shift));
+            visitedCells++;
+        }
+        else if (row == 0 && col == 0) {
+            break;
+        }
+        else {
+            int id = row * cols + col;
+            int back = (cameFrom[id >> 2] >> ((id & 3) * 2)) & 3;
+            row += DIR_DR[back];
+            col += DIR_DC[back];
+        }
+    }
+
+    return visitedCells;
+}
+
+#endif
@@ -0,0 +1,108 @@
+﻿#include "MazePregenerator.h"
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+MazePregenerator::MazePregenerator() : stopping(false), hasWanted(false), ready(false) {
+    worker = std::thread(&MazePregenerator::run, this);
+}
+
+MazePregenerator::~MazePregenerator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void MazePregenerator::request(int rows, int cols, MazeAlgorithm algorithm) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Config config = { rows, cols, algorithm };
+        if (hasWanted && wanted == config) return;
+        wanted = config;
+        hasWanted = true;
+    }
+    wake.notify_one();
+}
+
+bool MazePregenerator::isReady(int rows, int cols, MazeAlgorithm algorithm) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Config config = { rows, cols, algorithm };
+    return ready && readyConfig == config;
+}
+
+bool MazePregenerator::takeReady(int rows, int cols, MazeAlgorithm algorithm,
+    Maze& target, SolveResult& solution) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Config config = { rows, cols, algorithm };
+        if (!ready || !(readyConfig == config)) {
+            return false;
+        }
+
+        // Intercambio de planos: 'target' recibe el laberinto nuevo sin copias
+        std::swap(target, *readyMaze);
+        solution = readySolution;
+        ready = false;
+    }
+    wake.notify_one();
+    return true;
+}
+
+bool MazePregenerator::isWanted(const Config& job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !stopping && hasWanted && wanted == job;
+}
+
+void MazePregenerator::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        wake.wait(lock, [this]() {
+            return stopping || (hasWanted && !(ready && readyConfig == wanted));
+        });
+        if (stopping) break;
+
+        Config job = wanted;
+        lock.unlock();
+
+        // Generar y resolver fuera del cerrojo: el hilo principal sigue libre
+        std::unique_ptr<Maze> built;
+        SolveResult solution;
+        try {
+            built.reset(new Maze(job.rows, job.cols));
+            bool useTree = recordTreePaysOff(job.algorithm);
+            MazeGenerator generator(built.get());
+            generator.setRecordTree(useTree);
+            generator.generate(job.algorithm);
+
+            // No resolver si ya se está cerrando o la petición cambió
+            if (isWanted(job)) {
+                MazeSolver solver(built.get());
+                solver.setVerbose(false);
+                solution = useTree ? solver.solveFromTree(generator.getSpanningTree()) : solver.solveBFS();
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: Pregeneration failed - " << e.what() << std::endl;
+            built.reset();
+        }
+
+        lock.lock();
+        if (!built) {
+            // Configuración inválida: no reintentar hasta que se pida otra
+            if (wanted == job) hasWanted = false;
+            continue;
+        }
+        if (stopping || !(wanted == job)) {
+            // La petición cambió mientras se generaba: se descarta
+            continue;
+        }
+        readyMaze = std::move(built);
+        readySolution = solution;
+        readyConfig = job;
+        ready = true;
+    }
+}
@@ -0,0 +1,67 @@
+﻿#ifndef MAZE_PREGENERATOR_H
+#define MAZE_PREGENERATOR_H
+
+#include "Maze.h"
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+// Servicio de pregeneración: un hilo de trabajo genera y resuelve el
+// siguiente laberinto para la configuración pedida, de modo que cambiar de
+// laberinto es intercambiar memoria en lugar de generar dentro del bucle.
+class MazePregenerator {
+private:
+    struct Config {
+        int rows;
+        int cols;
+        MazeAlgorithm algorithm;
+
+        bool operator==(const Config& other) const {
+            return rows == other.rows && cols == other.cols && algorithm == other.algorithm;
+        }
+    };
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+
+    // Configuración pedida (la que debe estar lista)
+    bool hasWanted;
+    Config wanted;
+
+    // Laberinto terminado, con su solución
+    bool ready;
+    Config readyConfig;
+    std::unique_ptr<Maze> readyMaze;
+    SolveResult readySolution;
+
+    // Si 'job' sigue siendo lo pedido y no se está cerrando (toma el cerrojo)
+    bool isWanted(const Config& job);
+
+    void run();
+
+public:
+    MazePregenerator();
+    ~MazePregenerator();
+
+    MazePregenerator(const MazePregenerator&) = delete;
+    MazePregenerator& operator=(const MazePregenerator&) = delete;
+
+    // Pedir que haya un laberinto listo con esta configuración. Si cambia,
+    // el que estuviera en curso se abandona (sin resolverlo) y se descarta.
+    void request(int rows, int cols, MazeAlgorithm algorithm);
+
+    // Si hay uno listo con esta configuración, intercambiarlo con 'target'
+    // (O(1), 'target' conserva su dirección) y copiar su solución en
+    // 'solution'; el siguiente se empieza a generar enseguida.
+    // Devuelve false si aún no está listo.
+    bool takeReady(int rows, int cols, MazeAlgorithm algorithm, Maze& target, SolveResult& solution);
+
+    bool isReady(int rows, int cols, MazeAlgorithm algorithm);
+};
+
+#endif
@@ -0,0 +1,151 @@
+﻿#ifndef MAZE_RNG_H
+#define MAZE_RNG_H
+
+#include "CounterRng.h"
+#include <random>
+#include <algorithm>
+#include <cstdint>
+
+// Políticas de números aleatorios para BasicMazeGenerator. Cada una ofrece:
+//   seed(s)         reiniciar con una semilla
+//   next32()        32 bits aleatorios
+//   below(n)        entero uniforme en [0, n)
+//   shuffle(a, b)   barajar un rango
+// y es además un generador uniforme de bits (operator(), min(), max()).
+
+// std::mt19937 con std::uniform_int_distribution: la misma secuencia de
+// números que en versiones anteriores. Eller's y Prim's sin setLegacyPrims(true)
+// consumen esa secuencia de otra forma y dan laberintos distintos a los de antes
+class Mt19937Rng {
+private:
+    std::mt19937 engine;
+
+public:
+    typedef std::mt19937::result_type result_type;
+
+    void seed(uint64_t s) { engine.seed(static_cast<std::mt19937::result_type>(s)); }
+
+    result_type operator()() { return engine(); }
+    static result_type min() { return std::mt19937::min(); }
+    static result_type max() { return std::mt19937::max(); }
+
+    uint32_t next32() { return static_cast<uint32_t>(engine()); }
+
+    int below(int n) {
+        std::uniform_int_distribution<int> dist(0, n - 1);
+        return dist(engine);
+    }
+
+    template <typename It>
+    void shuffle(It first, It last) { std::shuffle(first, last, engine); }
+};
+
+// Entero en [0, n) con el método casi sin divisiones de Lemire: un producto
+// de 32x32 bits y, solo en el caso raro de sesgo, un módulo y un reintento
+template <typename Source>
+inline int lemireBelow(Source& source, uint32_t n) {
+    uint64_t m = static_cast<uint64_t>(source.next32()) * n;
+    uint32_t low = static_cast<uint32_t>(m);
+    if (low < n) {
+        uint32_t threshold = (0u - n) % n;
+        while (low < threshold) {
+            m = static_cast<uint64_t>(source.next32()) * n;
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return static_cast<int>(m >> 32);
+}
+
+// Fisher-Yates con muestreo acotado de la propia política
+template <typename Source, typename It>
+inline void boundedShuffle(Source& source, It first, It last) {
+    for (auto i = last - first - 1; i > 0; i--) {
+        std::iter_swap(first + i, first + lemireBelow(source, static_cast<uint32_t>(i + 1)));
+    }
+}
+
+// xoshiro256** (Blackman y Vigna): 32 bytes de estado, muy rápido
+class Xoshiro256Rng {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    typedef uint64_t result_type;
+
+    Xoshiro256Rng() { seed(0); }
+
+    // El estado se rellena con SplitMix64, como recomiendan los autores
+    void seed(uint64_t value) {
+        for (int i = 0; i < 4; i++) {
+            value += 0x9E3779B97F4A7C15ULL;
+            s[i] = CounterRng::mix(value);
+        }
+    }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+    static result_type min() { return 0; }
+    static result_type max() { return ~uint64_t(0); }
+
+    uint32_t next32() { return static_cast<uint32_t>((*this)() >> 32); }
+    int below(int n) { return lemireBelow(*this, static_cast<uint32_t>(n)); }
+
+    template <typename It>
+    void shuffle(It first, It last) { boundedShuffle(*this, first, last); }
+};
+
+// wyrand (Wang Yi): 8 bytes de estado, un producto de 64x64 bits por número
+class WyRandRng {
+private:
+    uint64_t state;
+
+    static uint64_t mum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+        // Producto de 128 bits por mitades de 32 (MSVC no tiene __int128)
+        uint64_t aLo = a & 0xFFFFFFFFULL, aHi = a >> 32;
+        uint64_t bLo = b & 0xFFFFFFFFULL, bHi = b >> 32;
+        uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+        uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL);
+        uint64_t lo = (mid << 32) | (ll & 0xFFFFFFFFULL);
+        uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        return lo ^ hi;
+#endif
+    }
+
+public:
+    typedef uint64_t result_type;
+
+    WyRandRng() : state(0) {
+    }
+
+    void seed(uint64_t value) { state = value; }
+
+    result_type operator()() {
+        state += 0xA0761D6478BD642FULL;
+        return mum(state, state ^ 0xE7037ED1A0B428DBULL);
+    }
+    static result_type min() { return 0; }
+    static result_type max() { return ~uint64_t(0); }
+
+    uint32_t next32() { return static_cast<uint32_t>((*this)() >> 32); }
+    int below(int n) { return lemireBelow(*this, static_cast<uint32_t>(n)); }
+
+    template <typename It>
+    void shuffle(It first, It last) { boundedShuffle(*this, first, last); }
+};
+
+#endif
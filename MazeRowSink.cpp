@@ -0,0 +1,38 @@
+﻿#include "MazeRowSink.h"
+#include "Maze.h"
+#include <iostream>
+
+void MazeGridSink::consumeRow(long long row, const uint64_t* rightWalls,
+    const uint64_t* bottomWalls, int) {
+    maze->setWallRow(static_cast<int>(row), rightWalls, bottomWalls);
+}
+
+MazeRowFileWriter::MazeRowFileWriter(const std::string& filename, long long rows, int cols)
+    : file(filename, std::ios::binary | std::ios::trunc), rowsWritten(0) {
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file for writing: " << filename << std::endl;
+        return;
+    }
+
+    const char magic[4] = { 'M', 'Z', 'R', 'S' };
+    uint32_t version = 1;
+    int64_t rowCount = rows;
+    int32_t colCount = cols;
+    int32_t wordsPerRow = (cols + 63) / 64;
+
+    file.write(magic, sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&rowCount), sizeof(rowCount));
+    file.write(reinterpret_cast<const char*>(&colCount), sizeof(colCount));
+    file.write(reinterpret_cast<const char*>(&wordsPerRow), sizeof(wordsPerRow));
+}
+
+void MazeRowFileWriter::consumeRow(long long, const uint64_t* rightWalls,
+    const uint64_t* bottomWalls, int cols) {
+    if (!file.is_open()) return;
+
+    std::streamsize bytes = static_cast<std::streamsize>((cols + 63) / 64 * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(rightWalls), bytes);
+    file.write(reinterpret_cast<const char*>(bottomWalls), bytes);
+    rowsWritten++;
+}
@@ -0,0 +1,52 @@
+﻿#ifndef MAZE_ROW_SINK_H
+#define MAZE_ROW_SINK_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+class Maze;
+
+// Receptor de filas terminadas durante la generación en streaming.
+// Cada plano trae (cols + 63) / 64 palabras; bit c = pared de la columna c
+// (1 = pared presente), con el mismo formato que los planos de Maze.
+class MazeRowSink {
+public:
+    virtual ~MazeRowSink() {}
+
+    virtual void consumeRow(long long row, const uint64_t* rightWalls,
+        const uint64_t* bottomWalls, int cols) = 0;
+};
+
+// Copia cada fila en un Maze ya creado con las mismas dimensiones
+class MazeGridSink : public MazeRowSink {
+private:
+    Maze* maze;
+
+public:
+    explicit MazeGridSink(Maze* m) : maze(m) {
+    }
+
+    void consumeRow(long long row, const uint64_t* rightWalls,
+        const uint64_t* bottomWalls, int cols) override;
+};
+
+// Escribe las filas en un archivo binario sin guardar el laberinto en memoria.
+// Formato: cabecera (magic "MZRS", versión, filas, columnas, palabras por fila)
+// seguida, por cada fila, de las palabras del plano derecho y del inferior.
+class MazeRowFileWriter : public MazeRowSink {
+private:
+    std::ofstream file;
+    long long rowsWritten;
+
+public:
+    MazeRowFileWriter(const std::string& filename, long long rows, int cols);
+
+    bool isOpen() const { return file.is_open(); }
+    long long getRowsWritten() const { return rowsWritten; }
+
+    void consumeRow(long long row, const uint64_t* rightWalls,
+        const uint64_t* bottomWalls, int cols) override;
+};
+
+#endif
@@ -1,162 +1,587 @@
 ﻿#include "MazeSolver.h"
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
 
-MazeSolver::MazeSolver(Maze* m) : maze(m) {
+void CellQueue::grow() {
+    size_t capacity = buffer.empty() ? 64 : buffer.size() * 2;
+    std::vector<int> grown(capacity);
+    for (size_t i = 0; i < count; i++) {
+        grown[i] = buffer[(head + i) & (buffer.size() - 1)];
+    }
+    buffer.swap(grown);
+    head = 0;
+}
+
+void BucketQueue::clear(int startPriority) {
+    for (std::vector<int>& bucket : buckets) {
+        bucket.clear();
+    }
+    head = 0;
+    currentPriority = startPriority;
+    count = 0;
+}
+
+void BucketQueue::grow(size_t span) {
+    size_t capacity = buckets.empty() ? 4 : buckets.size();
+    while (capacity < span) capacity *= 2;
+
+    // Reordenar el anillo para que el cubo actual quede en la posición 0
+    std::vector<std::vector<int>> grown(capacity);
+    for (size_t i = 0; i < buckets.size(); i++) {
+        grown[i].swap(buckets[(head + i) & (buckets.size() - 1)]);
+    }
+    buckets.swap(grown);
+    head = 0;
+}
+
+MazeSolver::MazeSolver(Maze* m) : maze(m), mode(SOLVE_BFS), markSolution(true), compactParents(false),
+    verbose(true), searchStamp(0), parallelSearch(m), floodFill(m) {
     if (maze == nullptr) {
         std::cerr << "Error: MazeSolver initialized with null maze!" << std::endl;
     }
 }
 
-bool MazeSolver::canMove(Cell* from, Cell* to) const {
-    if (from == nullptr || to == nullptr) {
-        return false;
+void MazeSolver::setParent(int cell, int parent, int dirToParent) {
+    if (compactParents) {
+        int shift = (cell & 3) * 2;
+        uint8_t& packed = parentDirs[cell >> 2];
+        packed = static_cast<uint8_t>((packed & ~(3 << shift)) | (dirToParent << shift));
     }
+    else {
+        parentIndex[cell] = parent;
+    }
+}
 
-    int dr = to->row - from->row;
-    int dc = to->col - from->col;
+int MazeSolver::getParent(int cell) const {
+    if (!compactParents) {
+        return parentIndex[cell];
+    }
 
-    
-    if ((dr != 0 && dc != 0) || (dr == 0 && dc == 0)) {
-        return false;
+    int dir = (parentDirs[cell >> 2] >> ((cell & 3) * 2)) & 3;
+    int cols = maze->getCols();
+    return cell + DIR_DR[dir] * cols + DIR_DC[dir];
+}
+
+void MazeSolver::collectPath(int start, int end, std::vector<int>& path) const {
+    int current = end;
+    path.push_back(current);
+    while (current != start) {
+        current = getParent(current);
+        path.push_back(current);
     }
+    std::reverse(path.begin(), path.end());
+}
 
-    
-    if (dr < -1 || dr > 1 || dc < -1 || dc > 1) {
+void MazeSolver::reconstructPath(int start, int end) {
+    collectPath(start, end, lastResult.path);
+    finishPath();
+}
+
+void MazeSolver::finishPath() {
+    int cols = maze->getCols();
+    const std::vector<int>& path = lastResult.path;
+
+    lastResult.found = true;
+    lastResult.length = static_cast<int>(path.size());
+
+    if (markSolution) {
+        for (int cell : path) {
+            maze->setInSolution(cell / cols, cell % cols, true);
+        }
+    }
+
+    if (verbose) {
+        std::cout << "Solution path found: " << lastResult.length << " steps" << std::endl;
+    }
+}
+
+bool MazeSolver::prepareSearch() {
+    // 초기화
+    maze->clearVisited();
+    maze->clearSolution();
+
+    queue.clear();
+    reserveParents();
+
+    // 유효성 검증
+    if (maze->getGoals().empty()) {
+        std::cerr << "Error: No end point registered in maze!" << std::endl;
         return false;
     }
+    return true;
+}
+
+void MazeSolver::reserveParents() {
+    int totalCells = maze->getTotalCells();
+    if (compactParents) {
+        parentDirs.resize((totalCells + 3) / 4);
+    }
+    else {
+        parentIndex.resize(totalCells);
+    }
+}
+
+const SolveResult& MazeSolver::solve() {
+    switch (mode) {
+    case SOLVE_BIDIRECTIONAL:
+        return solveBidirectionalBFS();
+    case SOLVE_ASTAR:
+        return solveAStar();
+    case SOLVE_PARALLEL_BFS:
+        return solveParallelBFS();
+    case SOLVE_BIT_PARALLEL:
+        return solveBitParallel();
+    default:
+        return solveBFS();
+    }
+}
+
+const SolveResult& MazeSolver::solveBFS() {
+    lastResult.clear();
+
+    if (maze == nullptr) {
+        std::cerr << "Error: Cannot solve - maze is null!" << std::endl;
+        return lastResult;
+    }
+
+    if (!prepareSearch()) {
+        return lastResult;
+    }
+
+    // Inicio y metas: registro de extremos del laberinto, O(1)
+    int start = maze->getStartIndex();
+
+    // BFS 시작
+    int cols = maze->getCols();
+    maze->setVisited(start / cols, start % cols, true);
+    queue.push(start);
+    setParent(start, -1, 0);
+
+    int& nodesExplored = lastResult.nodesExplored;
+
+    while (!queue.empty()) {
+        int current = queue.pop();
+        nodesExplored++;
+
+        int row = current / cols;
+        int col = current % cols;
+
+        // 목표 지점 도달 (la primera meta alcanzada es la más cercana)
+        if (maze->isEndCell(row, col)) {
+            reconstructPath(start, current);
+            if (verbose) {
+                std::cout << "BFS explored " << nodesExplored << " nodes" << std::endl;
+            }
+            return lastResult;
+        }
+
+        maze->forEachNeighbor(row, col, maze->accessibleNeighborMask(row, col),
+            [&](int nextRow, int nextCol, int dir) {
+                if (!maze->isVisited(nextRow, nextCol)) {
+                    int next = maze->cellIndex(nextRow, nextCol);
+                    maze->setVisited(nextRow, nextCol, true);
+                    setParent(next, current, oppositeDirection(dir));
+                    queue.push(next);
+                }
+            });
+    }
 
     
-    if (dr == -1) return !from->topWall;      
-    if (dr == 1) return !from->bottomWall;    
-    if (dc == -1) return !from->leftWall;     
-    if (dc == 1) return !from->rightWall;     
+    std::cerr << "Warning: No path found from start to end!" << std::endl;
+    return lastResult;
+}
+
+const SolveResult& MazeSolver::solveBidirectionalBFS() {
+    lastResult.clear();
+
+    if (maze == nullptr) {
+        std::cerr << "Error: Cannot solve - maze is null!" << std::endl;
+        return lastResult;
+    }
+
+    if (!prepareSearch()) {
+        return lastResult;
+    }
+
+    int cols = maze->getCols();
+    int totalCells = maze->getTotalCells();
+    sideOf.resize(totalCells);
+    depthOf.resize(totalCells);
+
+    // Lado 0: desde el inicio; lado 1: desde todas las metas a la vez
+    auto visit = [&](int cell, int side, int depth) {
+        maze->setVisited(cell / cols, cell % cols, true);
+        sideOf[cell] = static_cast<uint8_t>(side);
+        depthOf[cell] = depth;
+        frontiers[side].push_back(cell);
+    };
+
+    int start = maze->getStartIndex();
+    frontiers[0].clear();
+    frontiers[1].clear();
+
+    if (maze->isEndCell(start / cols, start % cols)) {
+        lastResult.path.push_back(start);
+        finishPath();
+        return lastResult;
+    }
+
+    visit(start, 0, 0);
+    setParent(start, -1, 0);
+    for (int goal : maze->getGoals()) {
+        visit(goal, 1, 0);
+        setParent(goal, -1, 0);
+    }
+
+    // Se expande siempre un nivel completo de la frontera más pequeña. Al
+    // tocar el otro lado se termina ese nivel y se queda el encuentro más corto.
+    int explored[2] = { 0, 0 };
+    int bestLength = -1;
+    int meet[2] = { -1, -1 };
+
+    while (!frontiers[0].empty() && !frontiers[1].empty() && bestLength < 0) {
+        int side = frontiers[0].size() <= frontiers[1].size() ? 0 : 1;
+        nextFrontier.clear();
+
+        for (int current : frontiers[side]) {
+            explored[side]++;
+            int row = current / cols;
+            int col = current % cols;
+
+            maze->forEachNeighbor(row, col, maze->accessibleNeighborMask(row, col),
+                [&](int nextRow, int nextCol, int dir) {
+                    int next = maze->cellIndex(nextRow, nextCol);
+                    if (!maze->isVisited(nextRow, nextCol)) {
+                        maze->setVisited(nextRow, nextCol, true);
+                        sideOf[next] = static_cast<uint8_t>(side);
+                        depthOf[next] = depthOf[current] + 1;
+                        setParent(next, current, oppositeDirection(dir));
+                        nextFrontier.push_back(next);
+                    }
+                    else if (sideOf[next] != side) {
+                        int length = depthOf[current] + 1 + depthOf[next];
+                        if (bestLength < 0 || length < bestLength) {
+                            bestLength = length;
+                            meet[side] = current;
+                            meet[1 - side] = next;
+                        }
+                    }
+                });
+        }
 
-    return false;
+        frontiers[side].swap(nextFrontier);
+    }
+
+    lastResult.forwardExplored = explored[0];
+    lastResult.backwardExplored = explored[1];
+    lastResult.nodesExplored = explored[0] + explored[1];
+
+    if (bestLength < 0) {
+        std::cerr << "Warning: No path found from start to end!" << std::endl;
+        return lastResult;
+    }
+
+    // Unir las dos mitades: inicio -> meet[0] (invertida) y meet[1] -> meta
+    std::vector<int>& path = lastResult.path;
+    int cell = meet[0];
+    while (depthOf[cell] > 0) {
+        path.push_back(cell);
+        cell = getParent(cell);
+    }
+    path.push_back(cell);
+    std::reverse(path.begin(), path.end());
+
+    cell = meet[1];
+    while (depthOf[cell] > 0) {
+        path.push_back(cell);
+        cell = getParent(cell);
+    }
+    path.push_back(cell);
+
+    finishPath();
+    if (verbose) {
+        std::cout << "Bidirectional BFS explored " << lastResult.nodesExplored << " nodes ("
+            << explored[0] << " from start, " << explored[1] << " from goals)" << std::endl;
+    }
+    return lastResult;
 }
 
-int MazeSolver::calculatePathLength(Cell* end, std::map<Cell*, Cell*>& parent) const {
-    int length = 0;
-    Cell* current = end;
+int MazeSolver::runAStar(int start, int target, SolveResult& result) {
+    int cols = maze->getCols();
+    const std::vector<int>& goals = maze->getGoals();
+    const int* targets = target >= 0 ? &target : goals.data();
+    size_t targetCount = target >= 0 ? 1 : goals.size();
+
+    // Distancia Manhattan al objetivo más cercano (consistente: el mínimo de
+    // heurísticas consistentes lo es, así que f nunca baja al expandir)
+    auto heuristic = [&](int cell) {
+        int row = cell / cols;
+        int col = cell % cols;
+        int best = -1;
+        for (size_t i = 0; i < targetCount; i++) {
+            int distance = std::abs(row - targets[i] / cols) + std::abs(col - targets[i] % cols);
+            if (best < 0 || distance < best) best = distance;
+        }
+        return best;
+    };
+
+    size_t totalCells = static_cast<size_t>(maze->getTotalCells());
+    if (costFrom.size() < totalCells) {
+        costFrom.resize(totalCells);
+        costStamps.resize(totalCells, 0);
+    }
+    if (++searchStamp == 0) {
+        std::fill(costStamps.begin(), costStamps.end(), 0u);
+        searchStamp = 1;
+    }
+
+    costFrom[start] = 0;
+    costStamps[start] = searchStamp;
+    setParent(start, -1, 0);
+    openSet.clear(heuristic(start));
+    openSet.push(start, heuristic(start));
+    size_t peakOpen = 1;
+
+    // 'visited' marca las celdas cerradas; una celda puede estar varias veces
+    // en el abierto si se mejoró su coste, y las copias obsoletas se descartan
+    while (!openSet.empty()) {
+        int current = openSet.pop();
+        int row = current / cols;
+        int col = current % cols;
+
+        if (maze->isVisited(row, col)) continue;
+        maze->setVisited(row, col, true);
+        result.nodesExplored++;
+
+        if (target >= 0 ? current == target : maze->isEndCell(row, col)) {
+            result.peakOpenSize = static_cast<int>(peakOpen);
+            return current;
+        }
+
+        int nextCost = costFrom[current] + 1;
+        maze->forEachNeighbor(row, col, maze->accessibleNeighborMask(row, col),
+            [&](int nextRow, int nextCol, int dir) {
+                if (maze->isVisited(nextRow, nextCol)) return;
 
-    while (current != nullptr) {
-        length++;
-        current = parent[current];
+                int next = maze->cellIndex(nextRow, nextCol);
+                if (costStamps[next] == searchStamp && costFrom[next] <= nextCost) return;
+
+                costStamps[next] = searchStamp;
+                costFrom[next] = nextCost;
+                setParent(next, current, oppositeDirection(dir));
+                openSet.push(next, nextCost + heuristic(next));
+            });
+
+        if (openSet.size() > peakOpen) peakOpen = openSet.size();
     }
 
-    return length;
+    result.peakOpenSize = static_cast<int>(peakOpen);
+    return -1;
 }
 
-void MazeSolver::reconstructPath(Cell* end, std::map<Cell*, Cell*>& parent) {
-    if (end == nullptr) {
-        std::cerr << "Error: Cannot reconstruct path - end cell is null" << std::endl;
-        return;
+const SolveResult& MazeSolver::solveAStar() {
+    lastResult.clear();
+
+    if (maze == nullptr) {
+        std::cerr << "Error: Cannot solve - maze is null!" << std::endl;
+        return lastResult;
     }
 
-    Cell* current = end;
-    int pathLength = 0;
+    if (!prepareSearch()) {
+        return lastResult;
+    }
 
-    while (current != nullptr) {
-        current->inSolution = true;
-        current = parent[current];
-        pathLength++;
+    int start = maze->getStartIndex();
+    int end = runAStar(start, -1, lastResult);
+    if (end < 0) {
+        std::cerr << "Warning: No path found from start to end!" << std::endl;
+        return lastResult;
     }
 
-    std::cout << "Solution path found: " << pathLength << " steps" << std::endl;
+    reconstructPath(start, end);
+    if (verbose) {
+        std::cout << "A* expanded " << lastResult.nodesExplored << " nodes (peak open set "
+            << lastResult.peakOpenSize << ")" << std::endl;
+    }
+    return lastResult;
 }
 
-bool MazeSolver::solveBFS() {
+const SolveResult& MazeSolver::findPath(int fromRow, int fromCol, int toRow, int toCol) {
+    lastQuery.clear();
+
     if (maze == nullptr) {
         std::cerr << "Error: Cannot solve - maze is null!" << std::endl;
-        return false;
+        return lastQuery;
+    }
+
+    if (!maze->isValidCell(fromRow, fromCol) || !maze->isValidCell(toRow, toCol)) {
+        std::cerr << "Error: Invalid path query (" << fromRow << "," << fromCol << ") -> ("
+            << toRow << "," << toCol << ")" << std::endl;
+        return lastQuery;
     }
 
-    // 초기화
     maze->clearVisited();
-    maze->clearSolution();
+    reserveParents();
 
-    std::queue<Cell*> q;
-    std::map<Cell*, Cell*> parent;
+    int start = maze->cellIndex(fromRow, fromCol);
+    int end = runAStar(start, maze->cellIndex(toRow, toCol), lastQuery);
+    if (end < 0) {
+        return lastQuery;
+    }
 
-    // 시작점과 끝점 찾기
-    Cell* start = nullptr;
-    Cell* end = nullptr;
+    collectPath(start, end, lastQuery.path);
+    lastQuery.found = true;
+    lastQuery.length = static_cast<int>(lastQuery.path.size());
+    return lastQuery;
+}
 
-    for (int i = 0; i < maze->getRows(); i++) {
-        for (int j = 0; j < maze->getCols(); j++) {
-            if (maze->getCell(i, j).isStart) {
-                start = &maze->getCell(i, j);
-            }
-            if (maze->getCell(i, j).isEnd) {
-                end = &maze->getCell(i, j);
-            }
+const SolveResult& MazeSolver::solveParallelBFS(int threads) {
+    lastResult.clear();
+
+    if (maze == nullptr) {
+        std::cerr << "Error: Cannot solve - maze is null!" << std::endl;
+        return lastResult;
+    }
+
+    if (!prepareSearch()) {
+        return lastResult;
+    }
+
+    int start = maze->getStartIndex();
+    parallelSearch.setThreads(threads);
+    const ParallelBFSStats& stats = parallelSearch.run(start, &maze->getGoals());
+    lastResult.nodesExplored = static_cast<int>(stats.cellsReached);
+
+    // Meta más cercana
+    int end = -1;
+    int bestDistance = -1;
+    for (int goal : maze->getGoals()) {
+        int distance = parallelSearch.getDistance(goal);
+        if (distance >= 0 && (bestDistance < 0 || distance < bestDistance)) {
+            bestDistance = distance;
+            end = goal;
         }
     }
 
-    // 유효성 검증
-    if (start == nullptr || end == nullptr) {
-        std::cerr << "Error: Start or end point not found in maze!" << std::endl;
-        return false;
+    if (end < 0) {
+        std::cerr << "Warning: No path found from start to end!" << std::endl;
+        return lastResult;
     }
 
-    // BFS 시작
-    start->visited = true;
-    q.push(start);
-    parent[start] = nullptr;
+    // Bajar desde la meta: cada celda a distancia d > 0 tiene una vecina
+    // abierta a distancia d - 1
+    int cols = maze->getCols();
+    std::vector<int>& path = lastResult.path;
+    int current = end;
+    path.push_back(current);
+    for (int distance = bestDistance; distance > 0; distance--) {
+        int row = current / cols;
+        int col = current % cols;
+        int previous = current;
+        maze->forEachNeighbor(row, col, maze->accessibleNeighborMask(row, col),
+            [&](int nextRow, int nextCol, int) {
+                int next = maze->cellIndex(nextRow, nextCol);
+                if (previous == current && parallelSearch.getDistance(next) == distance - 1) {
+                    previous = next;
+                }
+            });
+        current = previous;
+        path.push_back(current);
+    }
+    std::reverse(path.begin(), path.end());
 
-    int nodesExplored = 0;
+    finishPath();
+    if (verbose) {
+        std::cout << "Parallel BFS reached " << stats.cellsReached << " cells in " << stats.levels
+            << " levels (" << stats.topDownLevels << " top-down, " << stats.bottomUpLevels
+            << " bottom-up) on " << stats.threads << " threads" << std::endl;
+    }
+    return lastResult;
+}
 
-    while (!q.empty()) {
-        Cell* current = q.front();
-        q.pop();
-        nodesExplored++;
+const SolveResult& MazeSolver::solveBitParallel() {
+    lastResult.clear();
 
-        // 목표 지점 도달
-        if (current == end) {
-            reconstructPath(end, parent);
-            std::cout << "BFS explored " << nodesExplored << " nodes" << std::endl;
-            return true;
-        }
+    if (maze == nullptr) {
+        std::cerr << "Error: Cannot solve - maze is null!" << std::endl;
+        return lastResult;
+    }
 
-        int row = current->row;
-        int col = current->col;
-
-        
-        Cell* neighbors[4] = {
-            maze->isValidCell(row - 1, col) ? &maze->getCell(row - 1, col) : nullptr, 
-            maze->isValidCell(row + 1, col) ? &maze->getCell(row + 1, col) : nullptr,  
-            maze->isValidCell(row, col - 1) ? &maze->getCell(row, col - 1) : nullptr,  
-            maze->isValidCell(row, col + 1) ? &maze->getCell(row, col + 1) : nullptr   
-        };
-
-        for (int i = 0; i < 4; i++) {
-            Cell* next = neighbors[i];
-            if (next && !next->visited && canMove(current, next)) {
-                next->visited = true;
-                parent[next] = current;
-                q.push(next);
-            }
-        }
+    if (!prepareSearch()) {
+        return lastResult;
     }
 
-    
-    std::cerr << "Warning: No path found from start to end!" << std::endl;
-    return false;
+    int end = floodFill.run(maze->getStartIndex(), maze->getGoals());
+    lastResult.nodesExplored = static_cast<int>(floodFill.getCellsReached());
+
+    if (end < 0 || !floodFill.tracePath(lastResult.path)) {
+        std::cerr << "Warning: No path found from start to end!" << std::endl;
+        return lastResult;
+    }
+
+    finishPath();
+    if (verbose) {
+        std::cout << "Bit-parallel flood fill reached " << lastResult.nodesExplored << " cells in "
+            << floodFill.getLevels() << " levels" << std::endl;
+    }
+    return lastResult;
 }
 
-int MazeSolver::getPathLength() const {
-    if (maze == nullptr) return 0;
+const SolveResult& MazeSolver::solveFromTree(const SpanningTree& tree) {
+    if (maze == nullptr) {
+        lastResult.clear();
+        std::cerr << "Error: Cannot solve - maze is null!" << std::endl;
+        return lastResult;
+    }
 
-    int length = 0;
-    for (int i = 0; i < maze->getRows(); i++) {
-        for (int j = 0; j < maze->getCols(); j++) {
-            if (maze->getCell(i, j).inSolution) {
-                length++;
-            }
+    if (tree.empty()) {
+        return solveBFS();
+    }
+
+    int start = maze->getStartIndex();
+    if (tree.getRows() != maze->getRows() || tree.getCols() != maze->getCols() || !tree.isRoot(start)) {
+        std::cerr << "Warning: Spanning tree does not match the maze, solving with BFS" << std::endl;
+        return solveBFS();
+    }
+
+    lastResult.clear();
+    maze->clearSolution();
+
+    const std::vector<int>& goals = maze->getGoals();
+    if (goals.empty()) {
+        std::cerr << "Error: No end point registered in maze!" << std::endl;
+        return lastResult;
+    }
+
+    // En un árbol el camino a cada meta es único: la más cercana es la menos profunda
+    int end = goals[0];
+    int bestDepth = tree.depth(end);
+    lastResult.nodesExplored = bestDepth + 1;
+    for (size_t i = 1; i < goals.size(); i++) {
+        int goalDepth = tree.depth(goals[i]);
+        lastResult.nodesExplored += goalDepth + 1;
+        if (goalDepth < bestDepth) {
+            bestDepth = goalDepth;
+            end = goals[i];
         }
     }
-    return length;
-}
 
-bool MazeSolver::hasSolution() const {
-    return getPathLength() > 0;
-}
\ No newline at end of file
+    tree.pathFromRoot(end, lastResult.path);
+
+    // Las paredes pueden haber cambiado desde la generación
+    int cols = maze->getCols();
+    for (size_t i = 1; i < lastResult.path.size(); i++) {
+        int cell = lastResult.path[i];
+        if (maze->hasWall(cell / cols, cell % cols, tree.getParentDir(cell))) {
+            std::cerr << "Warning: Spanning tree does not match the maze, solving with BFS" << std::endl;
+            return solveBFS();
+        }
+    }
+
+    finishPath();
+    if (verbose) {
+        std::cout << "Path read from spanning tree (" << lastResult.nodesExplored << " cells walked)" << std::endl;
+    }
+    return lastResult;
+}
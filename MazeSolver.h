@@ -2,35 +2,236 @@
 #define MAZE_SOLVER_H
 
 #include "Maze.h"
-#include <queue>
-#include <map>
+#include "ParallelBFS.h"
+#include "BitFloodFill.h"
+#include "SpanningTree.h"
 #include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Modos de resolución
+enum SolverMode {
+    SOLVE_BFS,              // BFS desde el inicio
+    SOLVE_BIDIRECTIONAL,    // BFS simultáneo desde el inicio y desde las metas
+    SOLVE_ASTAR,            // A* con distancia Manhattan
+    SOLVE_PARALLEL_BFS,     // BFS por niveles repartido entre varios hilos
+    SOLVE_BIT_PARALLEL      // Inundación de 64 celdas por palabra (AVX2 si hay)
+};
+
+// Resultado de una resolución
+struct SolveResult {
+    bool found;
+    std::vector<int> path;     // Índices de celda, del inicio a la meta
+    int length;                // Número de celdas del camino
+    int nodesExplored;         // Celdas sacadas de la cola (en total)
+    int forwardExplored;       // Bidireccional: celdas expandidas desde el inicio
+    int backwardExplored;      // Bidireccional: celdas expandidas desde las metas
+    int peakOpenSize;          // A*: tamaño máximo del conjunto abierto
+
+    SolveResult() : found(false), length(0), nodesExplored(0),
+        forwardExplored(0), backwardExplored(0), peakOpenSize(0) {
+    }
+
+    // Vaciar el resultado conservando la memoria del camino
+    void clear() {
+        found = false;
+        path.clear();
+        length = 0;
+        nodesExplored = 0;
+        forwardExplored = 0;
+        backwardExplored = 0;
+        peakOpenSize = 0;
+    }
+};
+
+// Cola circular de índices de celda. Crece por potencias de dos y conserva
+// su memoria entre resoluciones, así que tras la primera no vuelve a reservar.
+class CellQueue {
+private:
+    std::vector<int> buffer;
+    size_t head;
+    size_t count;
+
+    void grow();
+
+public:
+    CellQueue() : head(0), count(0) {
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    void clear() { head = 0; count = 0; }
+
+    void push(int cell) {
+        if (count == buffer.size()) grow();
+        buffer[(head + count) & (buffer.size() - 1)] = cell;
+        count++;
+    }
+
+    int pop() {
+        int cell = buffer[head];
+        head = (head + 1) & (buffer.size() - 1);
+        count--;
+        return cell;
+    }
+};
+
+// Cola de prioridad monótona por cubos para prioridades enteras que nunca
+// bajan de la última extraída (A* con heurística consistente). Los cubos
+// forman un anillo que solo cubre el rango de prioridades vivas: con pasos
+// de coste 1 y distancia Manhattan son dos (f y f + 2).
+class BucketQueue {
+private:
+    std::vector<std::vector<int>> buckets;
+    size_t head;                // Cubo de la prioridad actual
+    int currentPriority;
+    size_t count;
+
+    void grow(size_t span);
+
+public:
+    BucketQueue() : head(0), currentPriority(0), count(0) {
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    void clear(int startPriority);
+
+    // 'priority' debe ser >= que la última extraída
+    void push(int cell, int priority) {
+        size_t offset = static_cast<size_t>(priority - currentPriority);
+        if (offset >= buckets.size()) grow(offset + 1);
+        buckets[(head + offset) & (buckets.size() - 1)].push_back(cell);
+        count++;
+    }
+
+    // Extraer una celda de prioridad mínima (la última insertada entre iguales)
+    int pop() {
+        while (buckets[head].empty()) {
+            head = (head + 1) & (buckets.size() - 1);
+            currentPriority++;
+        }
+        int cell = buckets[head].back();
+        buckets[head].pop_back();
+        count--;
+        return cell;
+    }
+
+    int topPriority() const { return currentPriority; }
+};
 
 class MazeSolver {
 private:
     Maze* maze;
 
-    // Verificar si es posible moverse entre dos celdas
-    bool canMove(Cell* from, Cell* to) const;
+    // Opciones
+    SolverMode mode;        // Algoritmo que usa solve()
+    bool markSolution;      // Marcar 'inSolution' en las celdas del camino
+    bool compactParents;    // Guardar el padre como dirección de 2 bits
+    bool verbose;           // Mostrar el camino y las estadísticas por consola
+
+    // Memoria de trabajo reutilizada entre resoluciones.
+    // Padre de cada celda: índice lineal (modo normal) o dirección de
+    // 2 bits empaquetada, 4 celdas por byte (modo compacto)
+    std::vector<int> parentIndex;
+    std::vector<uint8_t> parentDirs;
+    CellQueue queue;
+
+    // Bidireccional: lado que visitó cada celda, su distancia a ese lado y
+    // las fronteras por niveles (solo se leen en celdas visitadas)
+    std::vector<uint8_t> sideOf;
+    std::vector<int> depthOf;
+    std::vector<int> frontiers[2];
+    std::vector<int> nextFrontier;
+
+    // A*: coste desde el origen, válido si su sello coincide con 'searchStamp'
+    BucketQueue openSet;
+    std::vector<int> costFrom;
+    std::vector<uint32_t> costStamps;
+    uint32_t searchStamp;
+
+    // BFS en paralelo (mapas de bits atómicos y distancias por celda)
+    ParallelBFS parallelSearch;
+
+    // Inundación por tableros de bits
+    BitFloodFill floodFill;
+
+    SolveResult lastResult;
+    SolveResult lastQuery;      // Última consulta de findPath()
+
+    void setParent(int cell, int parent, int dirToParent);
+    int getParent(int cell) const;
 
     // Reconstruir la ruta (retroceso)
-    void reconstructPath(Cell* end, std::map<Cell*, Cell*>& parent);
+    void collectPath(int start, int end, std::vector<int>& path) const;
+    void reconstructPath(int start, int end);
+
+    // Marcar y anunciar el camino ya guardado en lastResult.path
+    void finishPath();
 
-    // Calcular la longitud del camino
-    int calculatePathLength(Cell* end, std::map<Cell*, Cell*>& parent) const;
+    // Preparar estados y memoria de trabajo; false si no hay metas
+    bool prepareSearch();
+    void reserveParents();
+
+    // Núcleo de A* desde 'start' hasta 'target' (o hasta cualquier meta
+    // registrada si target < 0). Devuelve la celda alcanzada o -1 y anota
+    // en 'result' los nodos expandidos y el pico del conjunto abierto.
+    int runAStar(int start, int target, SolveResult& result);
 
 public:
     explicit MazeSolver(Maze* m);
 
+    // Resolver con el modo actual (por defecto BFS)
+    const SolveResult& solve();
+
     // Encontrar la ruta más corta usando BFS
-    bool solveBFS();
+    const SolveResult& solveBFS();
+
+    // BFS bidireccional: expande por niveles la frontera más pequeña (la del
+    // inicio o la de las metas) hasta que se tocan, y une las dos mitades
+    const SolveResult& solveBidirectionalBFS();
+
+    // A* del inicio a la meta más cercana con heurística Manhattan y
+    // conjunto abierto por cubos. Informa de nodos expandidos y pico del abierto.
+    const SolveResult& solveAStar();
+
+    // BFS en paralelo para laberintos muy grandes (threads = 0: todos los
+    // núcleos). El camino se recupera bajando por las distancias desde la meta.
+    const SolveResult& solveParallelBFS(int threads = 0);
+
+    // BFS por tableros de bits sobre los planos de paredes; el camino se
+    // recupera bajando por las capas de distancia desde la meta
+    const SolveResult& solveBitParallel();
+
+    // Leer el camino del árbol de expansión registrado al generar, en
+    // O(longitud del camino) y sin BFS. Si no hay árbol, no corresponde a este
+    // laberinto o sus aristas ya no están abiertas, resuelve con solveBFS().
+    const SolveResult& solveFromTree(const SpanningTree& tree);
+
+    // Consulta punto a punto con A* (p. ej. pistas durante la partida). No
+    // toca las marcas 'inSolution', los extremos ni getLastResult().
+    const SolveResult& findPath(int fromRow, int fromCol, int toRow, int toCol);
+
+    // Resultado de la última resolución
+    const SolveResult& getLastResult() const { return lastResult; }
+
+    // Tomar como última resolución una calculada fuera (p. ej. por el
+    // pregenerador sobre el laberinto que acaba de intercambiarse)
+    void adoptResult(const SolveResult& result) { lastResult = result; }
+
+    void setMode(SolverMode newMode) { mode = newMode; }
+    SolverMode getMode() const { return mode; }
+    void setMarkSolution(bool enabled) { markSolution = enabled; }
+    void setCompactParents(bool enabled) { compactParents = enabled; }
+    // Desactivar para resolver sin salida por consola (p. ej. en hilos de fondo)
+    void setVerbose(bool enabled) { verbose = enabled; }
 
     // Devolver información sobre la ruta
-    int getPathLength() const;
+    int getPathLength() const { return lastResult.length; }
 
     // Verificar si existe una solución
-    bool hasSolution() const;
+    bool hasSolution() const { return lastResult.found; }
 };
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,352 @@
+﻿#include "ParallelBFS.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+
+ParallelBFS::ParallelBFS(const Maze* m) : maze(m), threads(1), bitWords(0),
+    level(0), bottomUp(false), nextChunk(0), generation(0), finished(0), stopping(false) {
+    setThreads(0);
+}
+
+ParallelBFS::~ParallelBFS() {
+    stopPool();
+}
+
+void ParallelBFS::setThreads(int count) {
+    if (count <= 0) {
+        count = static_cast<int>(std::thread::hardware_concurrency());
+        if (count <= 0) count = 1;
+    }
+    if (count != threads) {
+        stopPool();
+    }
+    threads = count;
+}
+
+void ParallelBFS::reserve(size_t cells) {
+    distance.resize(cells);
+
+    size_t words = (cells + 63) / 64;
+    if (words > bitWords) {
+        visitedBits.reset(new std::atomic<uint64_t>[words]);
+        frontierBits.reset(new std::atomic<uint64_t>[words]);
+        bitWords = words;
+        for (size_t w = 0; w < words; w++) {
+            frontierBits[w].store(0, std::memory_order_relaxed);
+        }
+    }
+    for (size_t w = 0; w < words; w++) {
+        visitedBits[w].store(0, std::memory_order_relaxed);
+    }
+}
+
+void ParallelBFS::startPool() {
+    // Cada hilo parte de la generación actual, así no se pierde el primer
+    // nivel aunque arranque después de que se anuncie
+    for (int i = 1; i < threads; i++) {
+        pool.push_back(std::thread(&ParallelBFS::workerLoop, this, i, generation));
+    }
+}
+
+void ParallelBFS::stopPool() {
+    if (pool.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+        generation++;
+    }
+    levelReady.notify_all();
+    for (std::thread& th : pool) {
+        th.join();
+    }
+    pool.clear();
+    stopping = false;
+}
+
+void ParallelBFS::expandShared() {
+    int workers = static_cast<int>(pool.size());
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        finished = 0;
+        generation++;
+    }
+    levelReady.notify_all();
+
+    expandLevel(0);
+
+    std::unique_lock<std::mutex> lock(poolMutex);
+    levelDone.wait(lock, [&]() { return finished == workers; });
+}
+
+void ParallelBFS::workerLoop(int worker, unsigned startGeneration) {
+    unsigned seen = startGeneration;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            levelReady.wait(lock, [&]() { return generation != seen; });
+            seen = generation;
+            if (stopping) return;
+        }
+
+        expandLevel(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            finished++;
+        }
+        levelDone.notify_one();
+    }
+}
+
+void ParallelBFS::expandLevel(int worker) {
+    if (bottomUp) expandBottomUp(worker);
+    else expandTopDown(worker);
+}
+
+void ParallelBFS::expandTopDown(int worker) {
+    std::vector<int>& next = localNext[worker];
+    int cols = maze->getCols();
+    int nextLevel = level + 1;
+    size_t count = frontier.size();
+
+    size_t first;
+    while ((first = nextChunk.fetch_add(CHUNK_CELLS)) < count) {
+        size_t last = std::min(count, first + CHUNK_CELLS);
+        for (size_t i = first; i < last; i++) {
+            int current = frontier[i];
+            int row = current / cols;
+            int col = current % cols;
+
+            maze->forEachNeighbor(row, col, maze->accessibleNeighborMask(row, col),
+                [&](int nextRow, int nextCol, int) {
+                    int cell = nextRow * cols + nextCol;
+                    if (claim(cell)) {
+                        distance[cell] = nextLevel;
+                        next.push_back(cell);
+                    }
+                });
+        }
+    }
+}
+
+void ParallelBFS::expandBottomUp(int worker) {
+    std::vector<int>& next = localNext[worker];
+    int cols = maze->getCols();
+    int totalCells = maze->getTotalCells();
+    int nextLevel = level + 1;
+    size_t words = (static_cast<size_t>(totalCells) + 63) / 64;
+
+    // Cada bloque de palabras del mapa pertenece a un solo hilo durante el
+    // nivel, así que las celdas reclamadas se escriben de una vez por palabra
+    size_t first;
+    while ((first = nextChunk.fetch_add(CHUNK_WORDS)) < words) {
+        size_t last = std::min(words, first + CHUNK_WORDS);
+        for (size_t w = first; w < last; w++) {
+            uint64_t pending = ~visitedBits[w].load(std::memory_order_relaxed);
+            if (w == words - 1 && (totalCells & 63) != 0) {
+                pending &= (uint64_t(1) << (totalCells & 63)) - 1;
+            }
+
+            uint64_t claimed = 0;
+            for (int bit = 0; bit < 64 && (pending >> bit) != 0; bit++) {
+                if (((pending >> bit) & 1) == 0) continue;
+
+                int cell = static_cast<int>(w * 64) + bit;
+                int row = cell / cols;
+                int col = cell % cols;
+                unsigned open = maze->accessibleNeighborMask(row, col);
+
+                for (int dir = 0; dir < 4; dir++) {
+                    if ((open & (1u << dir)) &&
+                        testBit(frontierBits.get(), cell + DIR_DR[dir] * cols + DIR_DC[dir])) {
+                        claimed |= uint64_t(1) << bit;
+                        distance[cell] = nextLevel;
+                        next.push_back(cell);
+                        break;
+                    }
+                }
+            }
+
+            if (claimed != 0) {
+                visitedBits[w].fetch_or(claimed, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+const ParallelBFSStats& ParallelBFS::run(int source, const std::vector<int>* stopCells) {
+    stats.clear();
+    stats.threads = threads;
+
+    if (maze == nullptr) {
+        std::cerr << "Error: Cannot search - maze is null!" << std::endl;
+        return stats;
+    }
+
+    int totalCells = maze->getTotalCells();
+    if (source < 0 || source >= totalCells) {
+        std::cerr << "Error: Invalid BFS source cell " << source << std::endl;
+        return stats;
+    }
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    reserve(totalCells);
+    localNext.resize(threads);
+    for (std::vector<int>& next : localNext) {
+        next.clear();
+    }
+
+    frontier.clear();
+    claim(source);
+    distance[source] = 0;
+    frontier.push_back(source);
+    level = 0;
+    bottomUp = false;
+    long long reached = 1;
+    size_t previousFrontier = 0;
+
+    auto reachedStop = [&]() {
+        if (stopCells == nullptr) return false;
+        for (int cell : *stopCells) {
+            if (testBit(visitedBits.get(), cell)) return true;
+        }
+        return false;
+    };
+
+    while (!frontier.empty() && !reachedStop()) {
+        // Elegir dirección (heurística de Beamer con celdas en lugar de aristas)
+        size_t frontierSize = frontier.size();
+        long long unvisited = totalCells - reached;
+        if (!bottomUp && static_cast<long long>(frontierSize) * ALPHA > unvisited) {
+            bottomUp = true;
+        }
+        else if (bottomUp && frontierSize < previousFrontier &&
+            static_cast<long long>(frontierSize) * BETA < totalCells) {
+            bottomUp = false;
+        }
+
+        if (bottomUp) {
+            for (int cell : frontier) {
+                frontierBits[cell >> 6].fetch_or(uint64_t(1) << (cell & 63), std::memory_order_relaxed);
+            }
+            stats.bottomUpLevels++;
+        }
+        else {
+            stats.topDownLevels++;
+        }
+
+        nextChunk.store(0, std::memory_order_relaxed);
+        if (threads > 1 && (bottomUp || frontierSize >= static_cast<size_t>(PARALLEL_CUTOFF))) {
+            if (pool.empty()) startPool();
+            expandShared();
+        }
+        else {
+            expandLevel(0);
+        }
+
+        if (bottomUp) {
+            for (int cell : frontier) {
+                frontierBits[cell >> 6].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        // Unir las fronteras de cada hilo en la del siguiente nivel
+        previousFrontier = frontierSize;
+        frontier.clear();
+        for (std::vector<int>& next : localNext) {
+            frontier.insert(frontier.end(), next.begin(), next.end());
+            next.clear();
+        }
+        reached += static_cast<long long>(frontier.size());
+        level++;
+        stats.levels++;
+    }
+
+    stats.cellsReached = reached;
+    stats.elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return stats;
+}
+
+void ParallelBFS::benchmark(const Maze& maze, int source, int maxThreads, int repetitions) {
+    int totalCells = maze.getTotalCells();
+    int cols = maze.getCols();
+    if (source < 0 || source >= totalCells) {
+        std::cerr << "Error: Invalid BFS source cell " << source << std::endl;
+        return;
+    }
+    if (maxThreads <= 0) {
+        maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+        if (maxThreads <= 0) maxThreads = 1;
+    }
+    if (repetitions <= 0) repetitions = 1;
+
+    // Referencia: BFS en serie con la distancia como marca de visitada
+    std::vector<int> reference(totalCells, -1);
+    std::vector<int> order;
+    order.reserve(totalCells);
+    double serialMs = 0.0;
+    for (int rep = 0; rep < repetitions; rep++) {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        std::fill(reference.begin(), reference.end(), -1);
+        order.clear();
+        reference[source] = 0;
+        order.push_back(source);
+        for (size_t head = 0; head < order.size(); head++) {
+            int current = order[head];
+            int row = current / cols;
+            int col = current % cols;
+            maze.forEachNeighbor(row, col, maze.accessibleNeighborMask(row, col),
+                [&](int nextRow, int nextCol, int) {
+                    int cell = nextRow * cols + nextCol;
+                    if (reference[cell] < 0) {
+                        reference[cell] = reference[current] + 1;
+                        order.push_back(cell);
+                    }
+                });
+        }
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count();
+        if (rep == 0 || ms < serialMs) serialMs = ms;
+    }
+
+    std::cout << "Parallel BFS benchmark: " << maze.getRows() << "x" << cols << " ("
+        << totalCells << " cells, " << order.size() << " reachable), best of "
+        << repetitions << std::endl;
+    std::ios::fmtflags savedFlags = std::cout.flags();
+    std::streamsize savedPrecision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  serial   " << std::setw(10) << serialMs << " ms  "
+        << std::setw(8) << order.size() / (serialMs * 1000.0) << " Mcells/s" << std::endl;
+
+    ParallelBFS search(&maze);
+    double oneThreadMs = 0.0;
+    for (int count = 1;; count = std::min(count * 2, maxThreads)) {
+        search.setThreads(count);
+        double bestMs = 0.0;
+        for (int rep = 0; rep < repetitions; rep++) {
+            double ms = search.run(source).elapsedMs;
+            if (rep == 0 || ms < bestMs) bestMs = ms;
+        }
+        if (count == 1) oneThreadMs = bestMs;
+
+        bool matches = true;
+        for (int cell = 0; cell < totalCells && matches; cell++) {
+            matches = search.getDistance(cell) == reference[cell];
+        }
+
+        const ParallelBFSStats& last = search.getStats();
+        std::cout << "  " << std::setw(3) << count << " thr  " << std::setw(10) << bestMs << " ms  "
+            << std::setw(8) << last.cellsReached / (bestMs * 1000.0) << " Mcells/s  x"
+            << oneThreadMs / bestMs << "  levels " << last.levels << " ("
+            << last.topDownLevels << " top-down, " << last.bottomUpLevels << " bottom-up)  "
+            << (matches ? "distances OK" : "DISTANCE MISMATCH") << std::endl;
+
+        if (count == maxThreads) break;
+    }
+    std::cout.flags(savedFlags);
+    std::cout.precision(savedPrecision);
+}
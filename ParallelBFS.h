@@ -0,0 +1,140 @@
+﻿#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include "Maze.h"
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+
+// Estadísticas del último recorrido en paralelo
+struct ParallelBFSStats {
+    int threads;
+    int levels;                // Niveles expandidos
+    int topDownLevels;         // ... desde la frontera hacia las vecinas libres
+    int bottomUpLevels;        // ... desde las celdas libres hacia la frontera
+    long long cellsReached;
+    double elapsedMs;
+
+    ParallelBFSStats() {
+        clear();
+    }
+
+    void clear() {
+        threads = 0;
+        levels = 0;
+        topDownLevels = 0;
+        bottomUpLevels = 0;
+        cellsReached = 0;
+        elapsedMs = 0.0;
+    }
+};
+
+// BFS por niveles sincronizados para laberintos muy grandes (10^7-10^8 celdas).
+// Cada nivel se reparte en bloques entre un grupo de hilos y las celdas se
+// reclaman con un fetch_or sobre un mapa de bits 'visited' atómico, así que
+// cada celda entra una sola vez en la frontera. Según el tamaño de la
+// frontera se alterna entre expansión descendente (la frontera busca vecinas
+// libres) y ascendente (cada celda libre busca una vecina en la frontera).
+// Una celda se descubre siempre en el nivel de su distancia, así que las
+// distancias coinciden con las del BFS en serie.
+class ParallelBFS {
+private:
+    const Maze* maze;
+    int threads;
+
+    // Distancia de cada celda; solo es válida si su bit 'visited' está activo
+    std::vector<int> distance;
+    std::unique_ptr<std::atomic<uint64_t>[]> visitedBits;
+    std::unique_ptr<std::atomic<uint64_t>[]> frontierBits;
+    size_t bitWords;
+
+    std::vector<int> frontier;
+    std::vector<std::vector<int>> localNext;   // Siguiente frontera de cada hilo
+
+    // Nivel en curso, compartido con el grupo de hilos
+    int level;
+    bool bottomUp;
+    std::atomic<size_t> nextChunk;
+
+    // Grupo de threads - 1 hilos, creado la primera vez que un nivel se
+    // reparte y conservado entre recorridos. Entre niveles repartidos los
+    // hilos duermen en 'levelReady' hasta que cambia 'generation'; al acabar
+    // su parte suman 'finished' y avisan por 'levelDone'.
+    std::vector<std::thread> pool;
+    std::mutex poolMutex;
+    std::condition_variable levelReady;
+    std::condition_variable levelDone;
+    unsigned generation;
+    int finished;
+    bool stopping;
+
+    ParallelBFSStats stats;
+
+    void reserve(size_t cells);
+    void startPool();
+    void stopPool();
+    void expandShared();
+    void workerLoop(int worker, unsigned startGeneration);
+    void expandLevel(int worker);
+    void expandTopDown(int worker);
+    void expandBottomUp(int worker);
+
+    // Reclamar una celda; true si este hilo es el primero en visitarla
+    bool claim(int cell) {
+        std::atomic<uint64_t>& word = visitedBits[cell >> 6];
+        uint64_t mask = uint64_t(1) << (cell & 63);
+        if (word.load(std::memory_order_relaxed) & mask) return false;
+        return (word.fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+    }
+
+    static bool testBit(const std::atomic<uint64_t>* bits, int cell) {
+        return ((bits[cell >> 6].load(std::memory_order_relaxed) >> (cell & 63)) & 1) != 0;
+    }
+
+public:
+    // Umbrales de cambio de dirección: pasar a ascendente cuando la frontera
+    // por ALPHA supera a las celdas sin visitar, y volver a descendente cuando
+    // la frontera decrece y por BETA queda por debajo del total de celdas
+    static const int ALPHA = 14;
+    static const int BETA = 24;
+
+    // Los niveles descendentes con menos celdas se expanden en un solo hilo
+    // (en laberintos perfectos la frontera suele ser estrecha)
+    static const int PARALLEL_CUTOFF = 4096;
+
+    static const int CHUNK_CELLS = 256;     // Bloque descendente (celdas de la frontera)
+    static const int CHUNK_WORDS = 64;      // Bloque ascendente (palabras del mapa)
+
+    explicit ParallelBFS(const Maze* m);
+    ~ParallelBFS();
+
+    ParallelBFS(const ParallelBFS&) = delete;
+    ParallelBFS& operator=(const ParallelBFS&) = delete;
+
+    // Número de hilos (0 = hardware_concurrency()). Si cambia, el grupo se
+    // detiene y se vuelve a crear cuando haga falta.
+    void setThreads(int count);
+    int getThreads() const { return threads; }
+
+    // Recorrer desde 'source'. Con 'stopCells' termina al acabar el primer
+    // nivel en que se alcanza alguna de esas celdas.
+    const ParallelBFSStats& run(int source, const std::vector<int>* stopCells = nullptr);
+
+    // Distancia a 'source' en el último recorrido (-1 si no se alcanzó)
+    int getDistance(int cell) const {
+        return testBit(visitedBits.get(), cell) ? distance[cell] : -1;
+    }
+
+    const ParallelBFSStats& getStats() const { return stats; }
+
+    // Medir el rendimiento con 1..maxThreads hilos (potencias de dos y el
+    // máximo) desde 'source' y comprobar las distancias contra un BFS en serie
+    static void benchmark(const Maze& maze, int source, int maxThreads, int repetitions);
+};
+
+#endif
@@ -9,19 +9,8 @@ Player::Player(Maze* m) : maze(m), row(0), col(0) {
 }
 
 void Player::reset() {
-    
-    for (int i = 0; i < maze->getRows(); i++) {
-        for (int j = 0; j < maze->getCols(); j++) {
-            if (maze->getCell(i, j).isStart) {
-                row = i;
-                col = j;
-                return;
-            }
-        }
-    }
-    
-    row = 0;
-    col = 0;
+    row = maze->getStartRow();
+    col = maze->getStartCol();
 }
 
 void Player::setPosition(int r, int c) {
@@ -33,13 +22,13 @@ void Player::setPosition(int r, int c) {
 }
 
 bool Player::canMoveInDirection(int dr, int dc) const {
-    const Cell& current = maze->getCell(row, col);
+    const Cell current = maze->getCell(row, col);
 
     
-    if (dr == -1 && current.topWall) return false;    
-    if (dr == 1 && current.bottomWall) return false; 
-    if (dc == -1 && current.leftWall) return false;   
-    if (dc == 1 && current.rightWall) return false;   
+    if (dr == -1 && current.topWall()) return false;    
+    if (dr == 1 && current.bottomWall()) return false; 
+    if (dc == -1 && current.leftWall()) return false;   
+    if (dc == 1 && current.rightWall()) return false;   
 
     return true;
 }
@@ -77,14 +66,14 @@ bool Player::move(int dr, int dc) {
 bool Player::hasWon() const {
     
     if (maze->isValidCell(row, col)) {
-        return maze->getCell(row, col).isEnd;
+        return maze->isEndCell(row, col);
     }
     return false;
 }
 
 bool Player::isAtStart() const {
     if (maze->isValidCell(row, col)) {
-        return maze->getCell(row, col).isStart;
+        return maze->isStartCell(row, col);
     }
     return false;
 }
@@ -0,0 +1,54 @@
+﻿#include "SpanningTree.h"
+#include <algorithm>
+
+void SpanningTree::reset(int r, int c) {
+    rows = r;
+    cols = c;
+    size_t cells = static_cast<size_t>(r) * c;
+    nodes.assign((cells + 1) / 2, static_cast<uint8_t>(ROOT_FLAG | (ROOT_FLAG << 4)));
+}
+
+void SpanningTree::clear() {
+    rows = 0;
+    cols = 0;
+    nodes.clear();
+}
+
+void SpanningTree::setParentDirs(const uint8_t* dirs, int root) {
+    int cells = rows * cols;
+    for (int cell = 0; cell < cells; cell++) {
+        setParent(cell, (dirs[cell >> 2] >> ((cell & 3) * 2)) & 3);
+    }
+    writeNode(root, ROOT_FLAG);
+}
+
+void SpanningTree::reroot(int cell) {
+    // Cada celda del camino pasa a colgar de la anterior
+    int current = cell;
+    unsigned newNode = ROOT_FLAG;
+    while (true) {
+        unsigned node = readNode(current);
+        writeNode(current, newNode);
+        if (node & ROOT_FLAG) break;
+
+        int up = static_cast<int>(node & 3);
+        newNode = static_cast<unsigned>(oppositeDirection(up));
+        current = neighborOf(current, up);
+    }
+}
+
+void SpanningTree::pathFromRoot(int cell, std::vector<int>& path) const {
+    path.clear();
+    for (int current = cell; current >= 0; current = getParent(current)) {
+        path.push_back(current);
+    }
+    std::reverse(path.begin(), path.end());
+}
+
+int SpanningTree::depth(int cell) const {
+    int steps = 0;
+    for (int current = cell; !isRoot(current); current = getParent(current)) {
+        steps++;
+    }
+    return steps;
+}
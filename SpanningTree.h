@@ -0,0 +1,79 @@
+﻿#ifndef SPANNING_TREE_H
+#define SPANNING_TREE_H
+
+#include "Maze.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Árbol de expansión de un laberinto perfecto registrado mientras se genera:
+// medio byte por celda con la dirección hacia el padre (bits 0-1) y la marca
+// de raíz (bit 2), juntas para que Kruskal's, que enlaza celdas en orden
+// aleatorio, toque una sola posición de memoria por celda. Durante la
+// generación puede ser un bosque (Kruskal's, Eller's); al terminar queda una
+// sola raíz, el inicio, y el camino a cualquier celda se lee en
+// O(longitud del camino).
+class SpanningTree {
+private:
+    int rows;
+    int cols;
+    std::vector<uint8_t> nodes;         // Dos celdas por byte
+
+    static const unsigned ROOT_FLAG = 4;
+
+    int neighborOf(int cell, int dir) const { return cell + DIR_DR[dir] * cols + DIR_DC[dir]; }
+
+    unsigned readNode(int cell) const { return (nodes[cell >> 1] >> ((cell & 1) * 4)) & 15; }
+
+    void writeNode(int cell, unsigned value) {
+        int shift = (cell & 1) * 4;
+        uint8_t& packed = nodes[cell >> 1];
+        packed = static_cast<uint8_t>((packed & ~(15 << shift)) | (value << shift));
+    }
+
+public:
+    SpanningTree() : rows(0), cols(0) {
+    }
+
+    // Empezar un bosque en el que cada celda es su propia raíz
+    void reset(int r, int c);
+
+    // Sin árbol (la última generación no lo registró)
+    void clear();
+
+    bool empty() const { return rows == 0; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    bool isRoot(int cell) const { return (readNode(cell) & ROOT_FLAG) != 0; }
+    int getParentDir(int cell) const { return static_cast<int>(readNode(cell) & 3); }
+    int getParent(int cell) const {
+        unsigned node = readNode(cell);
+        return (node & ROOT_FLAG) ? -1 : neighborOf(cell, static_cast<int>(node & 3));
+    }
+
+    // Colgar 'cell' (raíz) de su vecina en 'dir'
+    void setParent(int cell, int dir) { writeNode(cell, static_cast<unsigned>(dir)); }
+
+    // Tomar direcciones de 2 bits empaquetadas 4 por byte (las de llegada del
+    // backtracker sin pila); 'root' queda como única raíz
+    void setParentDirs(const uint8_t* dirs, int root);
+
+    // Hacer de 'cell' la raíz de su árbol invirtiendo el camino hasta la raíz
+    // anterior (coste: profundidad de 'cell')
+    void reroot(int cell);
+
+    // Unir el árbol de 'cell' al de su vecina en 'dir'
+    void link(int cell, int dir) {
+        reroot(cell);
+        setParent(cell, dir);
+    }
+
+    // Camino de la raíz a 'cell'
+    void pathFromRoot(int cell, std::vector<int>& path) const;
+    int depth(int cell) const;
+
+    size_t getMemoryBytes() const { return nodes.capacity(); }
+};
+
+#endif